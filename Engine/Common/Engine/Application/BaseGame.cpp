@@ -8,6 +8,10 @@
 // My Header
 #include "BaseGame.h"
 
+// Leggiero.Utility
+#include <Utility/Object/FrameArena.h>
+#include <Utility/Sugar/Finally.h>
+
 // Leggiero.Engine
 #include "GameProcessAnchor.h"
 
@@ -49,6 +53,9 @@ namespace Leggiero
 
 			m_processEventAnchor->NotifyAfterFrame(currentFrameNumber);
 
+			// Frame-transient data of the game thread expires here
+			Utility::Object::FrameArena::GetThreadArena().Reset();
+
 			return frameResult;
 		}
 
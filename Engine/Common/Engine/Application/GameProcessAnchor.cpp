@@ -19,6 +19,8 @@ namespace Leggiero
 
 		//------------------------------------------------------------------------------
 		GameProcessAnchor::GameProcessAnchor()
+			: m_mainThreadJobBudget(kDefaultMainThreadJobBudget.count())
+			, m_lastFrameProcessedJobCount(0), m_lastFrameDeferredJobCount(0)
 		{
 		}
 
@@ -99,6 +101,69 @@ namespace Leggiero
 			m_onShutdownNotifier.UnRegisterObserver(handler);
 		}
 
+		//------------------------------------------------------------------------------
+		void GameProcessAnchor::RequestMainThreadJob(const MainThreadJobType &job)
+		{
+			if (!job)
+			{
+				return;
+			}
+			m_mainThreadJobs.enqueue(job);
+		}
+
+		//------------------------------------------------------------------------------
+		void GameProcessAnchor::RequestMainThreadJob(MainThreadJobType &&job)
+		{
+			if (!job)
+			{
+				return;
+			}
+			m_mainThreadJobs.enqueue(std::move(job));
+		}
+
+		//------------------------------------------------------------------------------
+		void GameProcessAnchor::SetMainThreadJobBudget(GameTimeClockType::duration budget)
+		{
+			if (budget < GameTimeClockType::duration::zero())
+			{
+				budget = GameTimeClockType::duration::zero();
+			}
+			m_mainThreadJobBudget.store(budget.count(), std::memory_order_relaxed);
+		}
+
+		//------------------------------------------------------------------------------
+		// Run main thread jobs within the budget
+		void GameProcessAnchor::_ProcessMainThreadJobs()
+		{
+			// Jobs requested by the running jobs wait for the next frame
+			size_t waitingJobCount = m_mainThreadJobs.size_approx();
+			if (waitingJobCount == 0)
+			{
+				m_lastFrameProcessedJobCount = 0;
+				m_lastFrameDeferredJobCount = 0;
+				return;
+			}
+
+			GameTimeClockType::time_point budgetLimit = GameTimeClockType::now() + GetMainThreadJobBudget();
+
+			size_t processedJobCount = 0;
+			MainThreadJobType dequeuedJob;
+			while (processedJobCount < waitingJobCount && m_mainThreadJobs.try_dequeue(dequeuedJob))
+			{
+				dequeuedJob();
+				dequeuedJob = nullptr;
+				++processedJobCount;
+
+				if (GameTimeClockType::now() >= budgetLimit)
+				{
+					break;
+				}
+			}
+
+			m_lastFrameProcessedJobCount = processedJobCount;
+			m_lastFrameDeferredJobCount = m_mainThreadJobs.size_approx();
+		}
+
 		//------------------------------------------------------------------------------
 		void GameProcessAnchor::NotifyPrepare()
 		{
@@ -114,6 +179,8 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void GameProcessAnchor::NotifyBeforeFrame(GameFrameNumberType frameNumber, GameTimeClockType::time_point frameTime)
 		{
+			_ProcessMainThreadJobs();
+
 			m_onBeforeFrameNotifier.NotifyEvent([frameNumber, frameTime](GameProcessAnchorObserver::IBeforeFrameHandler *handler) { handler->GameProcess_OnBeforeFrame(frameNumber, frameTime); });
 		}
 
@@ -12,8 +12,12 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standard Library
+#include <atomic>
 #include <functional>
 
+// External Library
+#include <concurrentqueue/concurrentqueue.h>
+
 // Leggiero.Utility
 #include <Utility/Sugar/EventNotifier.h>
 
@@ -60,6 +64,26 @@ namespace Leggiero
 			void RegisterOnShutdown(GameProcessAnchorObserver::IShutdownHandler *handler);
 			void UnRegisterOnShutdown(GameProcessAnchorObserver::IShutdownHandler *handler);
 
+		public:	// Main Thread Jobs
+			using MainThreadJobType = std::function<void()>;
+
+			// Request a job to run on the game thread at the start of a frame; can be called from any thread
+			// Jobs requested from the same thread run in the order of request.
+			void RequestMainThreadJob(const MainThreadJobType &job);
+			void RequestMainThreadJob(MainThreadJobType &&job);
+
+			// Jobs are run until the budget spent in a frame, and left jobs are deferred to the next frame
+			// At least one job runs in a frame even if it is over the budget, to make progress.
+			void SetMainThreadJobBudget(GameTimeClockType::duration budget);
+			GameTimeClockType::duration GetMainThreadJobBudget() const { return GameTimeClockType::duration(m_mainThreadJobBudget.load(std::memory_order_relaxed)); }
+
+			// Approximate count of jobs waiting
+			size_t GetMainThreadJobBacklog() const { return m_mainThreadJobs.size_approx(); }
+
+			// Jobs run in the last frame, and jobs deferred from it
+			size_t GetLastFrameProcessedMainThreadJobCount() const { return m_lastFrameProcessedJobCount; }
+			size_t GetLastFrameDeferredMainThreadJobCount() const { return m_lastFrameDeferredJobCount; }
+
 		public:	// Notify Functions Called by Game
 			void NotifyPrepare();
 			void NotifyGraphicPrepare(bool isFirstPrepare);
@@ -68,6 +92,16 @@ namespace Leggiero
 			void NotifyGraphicShutdown();
 			void NotifyShutdown();
 
+		protected:
+			static constexpr GameTimeClockType::duration kDefaultMainThreadJobBudget = std::chrono::milliseconds(2);
+
+			void _ProcessMainThreadJobs();
+
+			moodycamel::ConcurrentQueue<MainThreadJobType>	m_mainThreadJobs;
+			std::atomic<GameTimeClockType::rep>				m_mainThreadJobBudget;
+			size_t											m_lastFrameProcessedJobCount;
+			size_t											m_lastFrameDeferredJobCount;
+
 		protected:	// Real Notifiers
 			Utility::DesignPattern::EventNotifier<GameProcessAnchorObserver::IPrepareHandler *>			m_onPrepareNotifier;
 			Utility::DesignPattern::EventNotifier<GameProcessAnchorObserver::IGraphicPrepareHandler *>	m_onGraphicPrepareNotifier;
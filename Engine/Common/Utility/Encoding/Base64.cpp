@@ -9,11 +9,16 @@
 
 // Standard Library
 #include <cstddef>
-#include <vector>
+#include <cstdint>
 
 // External Library
-#include <b64/encode.h>
-#include <b64/decode.h>
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+	#define _BASE64_USE_SSSE3
+	#include <tmmintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+	#define _BASE64_USE_NEON
+	#include <arm_neon.h>
+#endif
 
 
 namespace Leggiero
@@ -24,130 +29,544 @@ namespace Leggiero
 		{
 			namespace Base64
 			{
+				//////////////////////////////////////////////////////////////////////////////// Code Tables
+
+				namespace _Internal
+				{
+					namespace
+					{
+						constexpr char kStandardAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+						constexpr char kURLSafeAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+						constexpr uint8_t kInvalidCode = 0xff;
+
+						struct DecodeTable
+						{
+							uint8_t values[256];
+						};
+
+						//------------------------------------------------------------------------------
+						constexpr DecodeTable MakeDecodeTable(bool isURLSafe)
+						{
+							DecodeTable table { };
+							for (int i = 0; i < 256; ++i)
+							{
+								table.values[i] = kInvalidCode;
+							}
+							for (int i = 0; i < 64; ++i)
+							{
+								table.values[static_cast<uint8_t>(kStandardAlphabet[i])] = static_cast<uint8_t>(i);
+							}
+							if (isURLSafe)
+							{
+								table.values[static_cast<uint8_t>('-')] = 62;
+								table.values[static_cast<uint8_t>('_')] = 63;
+							}
+							return table;
+						}
+
+						constexpr DecodeTable kStandardDecodeTable = MakeDecodeTable(false);
+						constexpr DecodeTable kURLSafeDecodeTable = MakeDecodeTable(true);
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Vectorized Blocks
+
+				// Each function processes whole blocks from the start, and returns the consumed input size.
+				// Decoding stops at the first block having a character out of the alphabet, to be handled by the scalar path.
+
+				namespace _Internal
+				{
+					namespace
+					{
+					#if defined(_BASE64_USE_SSSE3)
+
+						//------------------------------------------------------------------------------
+						// 12 bytes to 16 characters per step; loads 16 bytes, so the last 4 bytes of input are left to the caller
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isURLSafe)
+						{
+							const __m128i kShuffleToGroups = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+							const __m128i kMaskAC = _mm_set1_epi32(0x0fc0fc00);
+							const __m128i kShiftAC = _mm_set1_epi32(0x04000040);
+							const __m128i kMaskBD = _mm_set1_epi32(0x003f03f0);
+							const __m128i kShiftBD = _mm_set1_epi32(0x01000010);
+
+							// Offsets from 6-bit index to character, selected by the index range
+							const __m128i kOffsetTable = isURLSafe
+								? _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0)
+								: _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+							size_t processedSize = 0;
+							while (dataSize - processedSize >= 16)
+							{
+								__m128i groups = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + processedSize)), kShuffleToGroups);
+								__m128i indices = _mm_or_si128(
+									_mm_mulhi_epu16(_mm_and_si128(groups, kMaskAC), kShiftAC),
+									_mm_mullo_epi16(_mm_and_si128(groups, kMaskBD), kShiftBD));
+
+								__m128i rangeKeys = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+								rangeKeys = _mm_or_si128(rangeKeys, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+								__m128i characters = _mm_add_epi8(indices, _mm_shuffle_epi8(kOffsetTable, rangeKeys));
+
+								_mm_storeu_si128(reinterpret_cast<__m128i *>(outBuffer), characters);
+								outBuffer += 16;
+								processedSize += 12;
+							}
+							return processedSize;
+						}
+
+						//------------------------------------------------------------------------------
+						// 16 characters to 12 bytes per step
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *base64Data, size_t base64Size, bool isURLSafe)
+						{
+							const __m128i kLowNibbleTable = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+							const __m128i kHighNibbleTable = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+							const __m128i kRollTable = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+							const __m128i kMask2F = _mm_set1_epi8(0x2f);
+							const __m128i kPackShuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+							size_t processedSize = 0;
+							while (base64Size - processedSize >= 16)
+							{
+								__m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i *>(base64Data + processedSize));
+								if (isURLSafe)
+								{
+									// Map to the standard alphabet: '-' to '+', '_' to '/'
+									characters = _mm_add_epi8(characters, _mm_and_si128(_mm_cmpeq_epi8(characters, _mm_set1_epi8('-')), _mm_set1_epi8('+' - '-')));
+									characters = _mm_add_epi8(characters, _mm_and_si128(_mm_cmpeq_epi8(characters, _mm_set1_epi8('_')), _mm_set1_epi8('/' - '_')));
+								}
+
+								__m128i highNibbles = _mm_and_si128(_mm_srli_epi32(characters, 4), kMask2F);
+								__m128i lowNibbles = _mm_and_si128(characters, kMask2F);
+								__m128i invalidCheck = _mm_and_si128(_mm_shuffle_epi8(kLowNibbleTable, lowNibbles), _mm_shuffle_epi8(kHighNibbleTable, highNibbles));
+								if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalidCheck, _mm_setzero_si128())) != 0)
+								{
+									break;
+								}
+
+								__m128i roll = _mm_shuffle_epi8(kRollTable, _mm_add_epi8(_mm_cmpeq_epi8(characters, kMask2F), highNibbles));
+								__m128i values = _mm_add_epi8(characters, roll);
+
+								__m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+								merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+								merged = _mm_shuffle_epi8(merged, kPackShuffle);
+
+								// Store exactly 12 bytes not to write over the output
+								_mm_storel_epi64(reinterpret_cast<__m128i *>(outBuffer), merged);
+								uint32_t lastWord = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(merged, 8)));
+								outBuffer[8] = static_cast<uint8_t>(lastWord);
+								outBuffer[9] = static_cast<uint8_t>(lastWord >> 8);
+								outBuffer[10] = static_cast<uint8_t>(lastWord >> 16);
+								outBuffer[11] = static_cast<uint8_t>(lastWord >> 24);
+
+								outBuffer += 12;
+								processedSize += 16;
+							}
+							return processedSize;
+						}
+
+						constexpr const char *kImplementationName = "SSSE3";
+
+					#elif defined(_BASE64_USE_NEON)
+
+						//------------------------------------------------------------------------------
+						// 48 bytes to 64 characters per step
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isURLSafe)
+						{
+							const uint8_t *alphabet = reinterpret_cast<const uint8_t *>(isURLSafe ? kURLSafeAlphabet : kStandardAlphabet);
+							uint8x16x4_t alphabetTable;
+							alphabetTable.val[0] = vld1q_u8(alphabet);
+							alphabetTable.val[1] = vld1q_u8(alphabet + 16);
+							alphabetTable.val[2] = vld1q_u8(alphabet + 32);
+							alphabetTable.val[3] = vld1q_u8(alphabet + 48);
+							const uint8x16_t kMask3F = vdupq_n_u8(0x3f);
+
+							size_t processedSize = 0;
+							while (dataSize - processedSize >= 48)
+							{
+								uint8x16x3_t bytes = vld3q_u8(data + processedSize);
+
+								uint8x16x4_t characters;
+								characters.val[0] = vshrq_n_u8(bytes.val[0], 2);
+								characters.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), kMask3F);
+								characters.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), kMask3F);
+								characters.val[3] = vandq_u8(bytes.val[2], kMask3F);
+
+								characters.val[0] = vqtbl4q_u8(alphabetTable, characters.val[0]);
+								characters.val[1] = vqtbl4q_u8(alphabetTable, characters.val[1]);
+								characters.val[2] = vqtbl4q_u8(alphabetTable, characters.val[2]);
+								characters.val[3] = vqtbl4q_u8(alphabetTable, characters.val[3]);
+
+								vst4q_u8(reinterpret_cast<uint8_t *>(outBuffer), characters);
+								outBuffer += 64;
+								processedSize += 48;
+							}
+							return processedSize;
+						}
+
+						//------------------------------------------------------------------------------
+						// 64 characters to 48 bytes per step
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *base64Data, size_t base64Size, bool isURLSafe)
+						{
+							const uint8_t *decodeValues = (isURLSafe ? kURLSafeDecodeTable : kStandardDecodeTable).values;
+							uint8x16x4_t lowTable;
+							uint8x16x4_t highTable;
+							for (int i = 0; i < 4; ++i)
+							{
+								lowTable.val[i] = vld1q_u8(decodeValues + 16 * i);
+								highTable.val[i] = vld1q_u8(decodeValues + 64 + 16 * i);
+							}
+							const uint8x16_t kHighOffset = vdupq_n_u8(64);
+							const uint8x16_t kMaxASCII = vdupq_n_u8(0x7f);
+
+							size_t processedSize = 0;
+							while (base64Size - processedSize >= 64)
+							{
+								uint8x16x4_t characters = vld4q_u8(reinterpret_cast<const uint8_t *>(base64Data + processedSize));
+
+								uint8x16_t invalidCheck = vdupq_n_u8(0);
+								for (int i = 0; i < 4; ++i)
+								{
+									uint8x16_t currentCharacters = characters.val[i];
+									uint8x16_t values = vqtbl4q_u8(lowTable, currentCharacters);
+									values = vqtbx4q_u8(values, highTable, vsubq_u8(currentCharacters, kHighOffset));
+									invalidCheck = vorrq_u8(invalidCheck, vorrq_u8(values, vcgtq_u8(currentCharacters, kMaxASCII)));
+									characters.val[i] = values;
+								}
+								if (vmaxvq_u8(invalidCheck) > 0x3f)
+								{
+									break;
+								}
+
+								uint8x16x3_t bytes;
+								bytes.val[0] = vorrq_u8(vshlq_n_u8(characters.val[0], 2), vshrq_n_u8(characters.val[1], 4));
+								bytes.val[1] = vorrq_u8(vshlq_n_u8(characters.val[1], 4), vshrq_n_u8(characters.val[2], 2));
+								bytes.val[2] = vorrq_u8(vshlq_n_u8(characters.val[2], 6), characters.val[3]);
+
+								vst3q_u8(outBuffer, bytes);
+								outBuffer += 48;
+								processedSize += 64;
+							}
+							return processedSize;
+						}
+
+						constexpr const char *kImplementationName = "NEON";
+
+					#else
+
+						//------------------------------------------------------------------------------
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isURLSafe)
+						{
+							(void)outBuffer;
+							(void)data;
+							(void)dataSize;
+							(void)isURLSafe;
+							return 0;
+						}
+
+						//------------------------------------------------------------------------------
+						// Whole valid quads, without the bookkeeping of skipped characters
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *base64Data, size_t base64Size, bool isURLSafe)
+						{
+							const uint8_t *decodeValues = (isURLSafe ? kURLSafeDecodeTable : kStandardDecodeTable).values;
+							const uint8_t *characters = reinterpret_cast<const uint8_t *>(base64Data);
+
+							size_t processedSize = 0;
+							while (base64Size - processedSize >= 4)
+							{
+								uint32_t value0 = decodeValues[characters[processedSize]];
+								uint32_t value1 = decodeValues[characters[processedSize + 1]];
+								uint32_t value2 = decodeValues[characters[processedSize + 2]];
+								uint32_t value3 = decodeValues[characters[processedSize + 3]];
+								if ((value0 | value1 | value2 | value3) > 0x3f)
+								{
+									break;
+								}
+
+								uint32_t quad = (value0 << 18) | (value1 << 12) | (value2 << 6) | value3;
+								outBuffer[0] = static_cast<uint8_t>(quad >> 16);
+								outBuffer[1] = static_cast<uint8_t>(quad >> 8);
+								outBuffer[2] = static_cast<uint8_t>(quad);
+
+								outBuffer += 3;
+								processedSize += 4;
+							}
+							return processedSize;
+						}
+
+						constexpr const char *kImplementationName = "Scalar";
+
+					#endif
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Codec
+
+				namespace _Internal
+				{
+					//------------------------------------------------------------------------------
+					size_t EncodeScalar(char *outBuffer, const uint8_t *data, size_t dataSize, bool isURLSafe)
+					{
+						const char *alphabet = (isURLSafe ? kURLSafeAlphabet : kStandardAlphabet);
+						char *writePosition = outBuffer;
+
+						size_t readPosition = 0;
+						for (; dataSize - readPosition >= 3; readPosition += 3)
+						{
+							uint32_t triple = (static_cast<uint32_t>(data[readPosition]) << 16) | (static_cast<uint32_t>(data[readPosition + 1]) << 8) | data[readPosition + 2];
+							writePosition[0] = alphabet[(triple >> 18) & 0x3f];
+							writePosition[1] = alphabet[(triple >> 12) & 0x3f];
+							writePosition[2] = alphabet[(triple >> 6) & 0x3f];
+							writePosition[3] = alphabet[triple & 0x3f];
+							writePosition += 4;
+						}
+
+						size_t leftSize = dataSize - readPosition;
+						if (leftSize > 0)
+						{
+							uint32_t triple = static_cast<uint32_t>(data[readPosition]) << 16;
+							if (leftSize > 1)
+							{
+								triple |= static_cast<uint32_t>(data[readPosition + 1]) << 8;
+							}
+							*writePosition++ = alphabet[(triple >> 18) & 0x3f];
+							*writePosition++ = alphabet[(triple >> 12) & 0x3f];
+							if (leftSize > 1)
+							{
+								*writePosition++ = alphabet[(triple >> 6) & 0x3f];
+							}
+							if (!isURLSafe)
+							{
+								*writePosition++ = '=';
+								if (leftSize == 1)
+								{
+									*writePosition++ = '=';
+								}
+							}
+						}
+
+						return static_cast<size_t>(writePosition - outBuffer);
+					}
+
+					//------------------------------------------------------------------------------
+					size_t DecodeScalar(uint8_t *outBuffer, const char *base64Data, size_t base64Size, bool isURLSafe)
+					{
+						const uint8_t *decodeValues = (isURLSafe ? kURLSafeDecodeTable : kStandardDecodeTable).values;
+						uint8_t *writePosition = outBuffer;
+
+						uint32_t quad = 0;
+						int quadCount = 0;
+						for (size_t i = 0; i < base64Size; ++i)
+						{
+							uint8_t currentValue = decodeValues[static_cast<uint8_t>(base64Data[i])];
+							if (currentValue == kInvalidCode)
+							{
+								// Padding and out of alphabet characters are skipped
+								continue;
+							}
+							quad = (quad << 6) | currentValue;
+							if (++quadCount == 4)
+							{
+								writePosition[0] = static_cast<uint8_t>(quad >> 16);
+								writePosition[1] = static_cast<uint8_t>(quad >> 8);
+								writePosition[2] = static_cast<uint8_t>(quad);
+								writePosition += 3;
+								quad = 0;
+								quadCount = 0;
+							}
+						}
+
+						if (quadCount == 2)
+						{
+							*writePosition++ = static_cast<uint8_t>(quad >> 4);
+						}
+						else if (quadCount == 3)
+						{
+							*writePosition++ = static_cast<uint8_t>(quad >> 10);
+							*writePosition++ = static_cast<uint8_t>(quad >> 2);
+						}
+
+						return static_cast<size_t>(writePosition - outBuffer);
+					}
+
+					namespace
+					{
+						//------------------------------------------------------------------------------
+						size_t EncodeWithBlocks(char *outBuffer, const void *data, size_t dataSize, bool isURLSafe)
+						{
+							const uint8_t *dataBytes = static_cast<const uint8_t *>(data);
+							size_t blockProcessedSize = EncodeBlocks(outBuffer, dataBytes, dataSize, isURLSafe);
+							size_t blockWrittenSize = blockProcessedSize / 3 * 4;
+							return blockWrittenSize + EncodeScalar(outBuffer + blockWrittenSize, dataBytes + blockProcessedSize, dataSize - blockProcessedSize, isURLSafe);
+						}
+
+						//------------------------------------------------------------------------------
+						// Vectorized blocks are used whenever the input is at a quad boundary; the scalar path takes over around skipped characters
+						size_t DecodeWithBlocks(void *outBuffer, const char *base64Data, size_t base64Size, bool isURLSafe)
+						{
+							const uint8_t *decodeValues = (isURLSafe ? kURLSafeDecodeTable : kStandardDecodeTable).values;
+							uint8_t *writePosition = static_cast<uint8_t *>(outBuffer);
+
+							uint32_t quad = 0;
+							int quadCount = 0;
+							size_t readPosition = 0;
+							while (readPosition < base64Size)
+							{
+								if (quadCount == 0)
+								{
+									size_t blockProcessedSize = DecodeBlocks(writePosition, base64Data + readPosition, base64Size - readPosition, isURLSafe);
+									readPosition += blockProcessedSize;
+									writePosition += blockProcessedSize / 4 * 3;
+									if (readPosition >= base64Size)
+									{
+										break;
+									}
+								}
+
+								uint8_t currentValue = decodeValues[static_cast<uint8_t>(base64Data[readPosition++])];
+								if (currentValue == kInvalidCode)
+								{
+									continue;
+								}
+								quad = (quad << 6) | currentValue;
+								if (++quadCount == 4)
+								{
+									writePosition[0] = static_cast<uint8_t>(quad >> 16);
+									writePosition[1] = static_cast<uint8_t>(quad >> 8);
+									writePosition[2] = static_cast<uint8_t>(quad);
+									writePosition += 3;
+									quad = 0;
+									quadCount = 0;
+								}
+							}
+
+							if (quadCount == 2)
+							{
+								*writePosition++ = static_cast<uint8_t>(quad >> 4);
+							}
+							else if (quadCount == 3)
+							{
+								*writePosition++ = static_cast<uint8_t>(quad >> 10);
+								*writePosition++ = static_cast<uint8_t>(quad >> 2);
+							}
+
+							return static_cast<size_t>(writePosition - static_cast<uint8_t *>(outBuffer));
+						}
+
+						//------------------------------------------------------------------------------
+						std::string EncodeToString(const std::string &data, bool isURLSafe)
+						{
+							std::string encodedString;
+							if (data.empty())
+							{
+								return encodedString;
+							}
+							encodedString.resize(CalculateEncodedSize(data.length()));
+							encodedString.resize(EncodeWithBlocks(&encodedString[0], data.data(), data.length(), isURLSafe));
+							return encodedString;
+						}
+
+						//------------------------------------------------------------------------------
+						std::string DecodeToString(const std::string &base64Data, bool isURLSafe)
+						{
+							std::string decodedString;
+							if (base64Data.length() < 2)
+							{
+								return decodedString;
+							}
+							decodedString.resize(CalculateDecodedSize(base64Data.length()));
+							decodedString.resize(DecodeWithBlocks(&decodedString[0], base64Data.data(), base64Data.length(), isURLSafe));
+							return decodedString;
+						}
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Interface
+
 				//------------------------------------------------------------------------------
 				std::string Encode(const std::string &data)
 				{
-					EncodeBufferType tempBuffer;
-					return EncodeInBuf(tempBuffer, data);
+					return _Internal::EncodeToString(data, false);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string Decode(const std::string &base64Data)
 				{
-					EncodeBufferType tempBuffer;
-					return DecodeInBuf(tempBuffer, base64Data);
+					return _Internal::DecodeToString(base64Data, false);
 				}
 
 				//------------------------------------------------------------------------------
+				// Intermediate buffer is not needed anymore; kept for compatibility
 				std::string EncodeInBuf(EncodeBufferType &buffer, const std::string &data)
 				{
-					if (data.empty())
-					{
-						return "";
-					}
-					buffer.resize(CalculateEncodedSize(data.length()) + 1);
-					base64::encoder E;
-					int length = E.encode(data.c_str(), (int)data.length(), &buffer[0]);
-					length += E.encode_end(&buffer[length]);
-					return std::string(&buffer[0], (size_t)length);
+					(void)buffer;
+					return _Internal::EncodeToString(data, false);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string DecodeInBuf(EncodeBufferType &buffer, const std::string &base64Data)
 				{
-					if (base64Data.length() == 0)
-					{
-						return "";
-					}
-					if (base64Data.length() % 4 != 0)
-					{
-						std::string paddedString(base64Data + std::string((size_t)(4 - (base64Data.length() % 4)), '='));
-						buffer.resize(CalculateDecodedSize(paddedString.length()) + 1);
-						base64::decoder D;
-						int length = D.decode(paddedString.c_str(), (int)paddedString.length(), &buffer[0]);
-						return std::string(&buffer[0], (size_t)length);
-					}
-					else
-					{
-						buffer.resize(CalculateDecodedSize(base64Data.length()) + 1);
-						base64::decoder D;
-						int length = D.decode(base64Data.c_str(), (int)base64Data.length(), &buffer[0]);
-						return std::string(&buffer[0], (size_t)length);
-					}
+					(void)buffer;
+					return _Internal::DecodeToString(base64Data, false);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string EncodeBase64URLSafe(const std::string &data)
 				{
-					EncodeBufferType tempBuffer;
-					return EncodeBase64URLSafeInBuf(tempBuffer, data);
+					return _Internal::EncodeToString(data, true);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string DecodeBase64URLSafe(const std::string &base64Data)
 				{
-					EncodeBufferType tempBuffer;
-					return DecodeBase64URLSafeInBuf(tempBuffer, base64Data);
+					return _Internal::DecodeToString(base64Data, true);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string EncodeBase64URLSafeInBuf(EncodeBufferType &buffer, const std::string &data)
 				{
-					if (data.empty())
-					{
-						return "";
-					}
-					buffer.resize(CalculateEncodedSize(data.length()) + 1);
-					base64::encoder E;
-					int length = E.encode(data.c_str(), (int)data.length(), &buffer[0]);
-					length += E.encode_end(&buffer[length]);
-					// Subs
-					for (int i = 0; i < length; ++i)
-					{
-						switch (buffer[i])
-						{
-							case '+': buffer[i] = '-'; break;
-							case '/': buffer[i] = '_'; break;
-						}
-					}
-					if (length < 3)
-					{
-						return std::string(&buffer[0], (size_t)length);
-					}
-					// Trim
-					while (buffer[length - 1] == '=' && length > 1)
-					{
-						--length;
-					}
-					return std::string(&buffer[0], (size_t)length);
+					(void)buffer;
+					return _Internal::EncodeToString(data, true);
 				}
 
 				//------------------------------------------------------------------------------
 				std::string DecodeBase64URLSafeInBuf(EncodeBufferType &buffer, const std::string &base64Data)
 				{
-					if (base64Data.empty())
-					{
-						return "";
-					}
-					std::string filteredData(base64Data);
-					size_t originalDataLength = base64Data.length();
-					switch (base64Data.length() % 4)
-					{
-						case 2: filteredData += "=="; break;
-						case 3: filteredData += '='; break;
-					}
-					for (int i = 0; i < originalDataLength; ++i)
-					{
-						switch (filteredData[i])
-						{
-							case '-': filteredData[i] = '+'; break;
-							case '_': filteredData[i] = '/'; break;
-						}
-					}
-					buffer.resize(CalculateDecodedSize(filteredData.length()) + 1);
-					base64::decoder D;
-					int length = D.decode(filteredData.c_str(), (int)filteredData.length(), &buffer[0]);
-					return std::string(&buffer[0], (size_t)length);
+					(void)buffer;
+					return _Internal::DecodeToString(base64Data, true);
+				}
+
+				//------------------------------------------------------------------------------
+				size_t EncodeTo(char *outBuffer, const void *data, size_t dataSize)
+				{
+					return _Internal::EncodeWithBlocks(outBuffer, data, dataSize, false);
+				}
+
+				//------------------------------------------------------------------------------
+				size_t DecodeTo(void *outBuffer, const char *base64Data, size_t base64Size)
+				{
+					return _Internal::DecodeWithBlocks(outBuffer, base64Data, base64Size, false);
+				}
+
+				//------------------------------------------------------------------------------
+				size_t EncodeBase64URLSafeTo(char *outBuffer, const void *data, size_t dataSize)
+				{
+					return _Internal::EncodeWithBlocks(outBuffer, data, dataSize, true);
+				}
+
+				//------------------------------------------------------------------------------
+				size_t DecodeBase64URLSafeTo(void *outBuffer, const char *base64Data, size_t base64Size)
+				{
+					return _Internal::DecodeWithBlocks(outBuffer, base64Data, base64Size, true);
+				}
+
+				//------------------------------------------------------------------------------
+				const char *GetImplementationName()
+				{
+					return _Internal::kImplementationName;
 				}
 			}
 		}
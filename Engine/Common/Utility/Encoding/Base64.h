@@ -12,6 +12,7 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standard Library
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,26 @@ namespace Leggiero
 				std::string DecodeBase64URLSafe(const std::string &base64Data);
 				std::string EncodeBase64URLSafeInBuf(EncodeBufferType &buffer, const std::string &data);
 				std::string DecodeBase64URLSafeInBuf(EncodeBufferType &buffer, const std::string &base64Data);
+
+				// Write directly to the caller's buffer, and return the written size
+				// Encoding needs CalculateEncodedSize(dataSize) bytes of outBuffer, and decoding needs CalculateDecodedSize(base64Size) bytes.
+				// Decoding accepts both padded and unpadded input, and skips characters not in the alphabet.
+				std::size_t EncodeTo(char *outBuffer, const void *data, std::size_t dataSize);
+				std::size_t DecodeTo(void *outBuffer, const char *base64Data, std::size_t base64Size);
+
+				// URL-safe encoding is not padded; URL-safe decoding also accepts the standard alphabet
+				std::size_t EncodeBase64URLSafeTo(char *outBuffer, const void *data, std::size_t dataSize);
+				std::size_t DecodeBase64URLSafeTo(void *outBuffer, const char *base64Data, std::size_t base64Size);
+
+				// Name of the vectorized code path compiled in: "SSSE3", "NEON", or "Scalar"
+				const char *GetImplementationName();
+
+				namespace _Internal
+				{
+					// Portable code paths, for verification and benchmark of the vectorized ones
+					std::size_t EncodeScalar(char *outBuffer, const uint8_t *data, std::size_t dataSize, bool isURLSafe);
+					std::size_t DecodeScalar(uint8_t *outBuffer, const char *base64Data, std::size_t base64Size, bool isURLSafe);
+				}
 			}
 		}
 	}
@@ -0,0 +1,264 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Encoding/EncodingBenchmark.cpp (Leggiero - Utility)
+//
+// Encoding benchmarks implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "EncodingBenchmark.h"
+
+// Standard Library
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+// Leggiero.Utility
+#include "Base64.h"
+#include "HexString.h"
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Encoding
+		{
+			//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+			namespace _Internal
+			{
+				namespace
+				{
+					using BenchmarkClock = std::chrono::steady_clock;
+
+					//------------------------------------------------------------------------------
+					std::string MakeBenchmarkData(size_t dataSize, uint32_t seed)
+					{
+						std::mt19937 randomGenerator(seed);
+						std::string data(dataSize, '\0');
+						for (char &currentByte : data)
+						{
+							currentByte = static_cast<char>(randomGenerator() & 0xff);
+						}
+						return data;
+					}
+
+					//------------------------------------------------------------------------------
+					// Repeat the job until the settings satisfied, and fill throughput
+					template <typename JobFuncT>
+					EncodingBenchmarkResult MeasureEncodingJob(const char *name, const char *variant, size_t dataSize, const EncodingBenchmarkSettings &settings, JobFuncT job)
+					{
+						EncodingBenchmarkResult result;
+						result.name = name;
+						result.variant = variant;
+						result.dataSize = dataSize;
+
+						// Warm up caches and lazy allocations
+						job();
+
+						uint64_t iterationCount = 0;
+						BenchmarkClock::time_point startTime = BenchmarkClock::now();
+						BenchmarkClock::duration elapsed;
+						do
+						{
+							job();
+							++iterationCount;
+							elapsed = BenchmarkClock::now() - startTime;
+						} while (iterationCount < settings.minimumIterationCount || elapsed < settings.minimumRunTime);
+
+						result.iterationCount = iterationCount;
+						result.elapsedMicroseconds = std::chrono::duration<double, std::micro>(elapsed).count();
+						if (result.elapsedMicroseconds > 0.0)
+						{
+							result.megabytesPerSecond = static_cast<double>(dataSize) * static_cast<double>(iterationCount) / result.elapsedMicroseconds;
+						}
+						return result;
+					}
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Benchmark Cases
+
+			namespace Benchmark
+			{
+				//------------------------------------------------------------------------------
+				// Encode and decode through caller buffers, on the compiled-in path and the portable path
+				// String interface cases include the allocation of results.
+				std::vector<EncodingBenchmarkResult> RunBase64(size_t dataSize, const EncodingBenchmarkSettings &settings)
+				{
+					std::vector<EncodingBenchmarkResult> results;
+
+					const std::string data(_Internal::MakeBenchmarkData(dataSize, settings.randomSeed));
+					const uint8_t *dataBytes = reinterpret_cast<const uint8_t *>(data.data());
+					const char *implementationName = Base64::GetImplementationName();
+
+					std::string referenceEncoded(Base64::CalculateEncodedSize(dataSize), '\0');
+					referenceEncoded.resize(Base64::_Internal::EncodeScalar(&referenceEncoded[0], dataBytes, dataSize, false));
+					std::string referenceURLSafeEncoded(Base64::CalculateEncodedSize(dataSize), '\0');
+					referenceURLSafeEncoded.resize(Base64::_Internal::EncodeScalar(&referenceURLSafeEncoded[0], dataBytes, dataSize, true));
+
+					std::vector<char> encodeBuffer(Base64::CalculateEncodedSize(dataSize) + 1);
+					std::vector<uint8_t> decodeBuffer(Base64::CalculateDecodedSize(referenceEncoded.length()) + 1);
+
+					size_t writtenSize = 0;
+					EncodingBenchmarkResult currentResult;
+
+					// Encode
+					currentResult = _Internal::MeasureEncodingJob("Base64Encode", implementationName, dataSize, settings,
+						[&]() { writtenSize = Base64::EncodeTo(&encodeBuffer[0], dataBytes, dataSize); });
+					currentResult.isVerified = (writtenSize == referenceEncoded.length() && memcmp(&encodeBuffer[0], referenceEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("Base64Encode", "Scalar", dataSize, settings,
+						[&]() { writtenSize = Base64::_Internal::EncodeScalar(&encodeBuffer[0], dataBytes, dataSize, false); });
+					currentResult.isVerified = (writtenSize == referenceEncoded.length() && memcmp(&encodeBuffer[0], referenceEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					// Decode
+					currentResult = _Internal::MeasureEncodingJob("Base64Decode", implementationName, dataSize, settings,
+						[&]() { writtenSize = Base64::DecodeTo(&decodeBuffer[0], referenceEncoded.data(), referenceEncoded.length()); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("Base64Decode", "Scalar", dataSize, settings,
+						[&]() { writtenSize = Base64::_Internal::DecodeScalar(&decodeBuffer[0], referenceEncoded.data(), referenceEncoded.length(), false); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					// URL-Safe (unpadded)
+					currentResult = _Internal::MeasureEncodingJob("Base64URLSafeEncode", implementationName, dataSize, settings,
+						[&]() { writtenSize = Base64::EncodeBase64URLSafeTo(&encodeBuffer[0], dataBytes, dataSize); });
+					currentResult.isVerified = (writtenSize == referenceURLSafeEncoded.length() && memcmp(&encodeBuffer[0], referenceURLSafeEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("Base64URLSafeDecode", implementationName, dataSize, settings,
+						[&]() { writtenSize = Base64::DecodeBase64URLSafeTo(&decodeBuffer[0], referenceURLSafeEncoded.data(), referenceURLSafeEncoded.length()); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					// String Interface
+					std::string stringResult;
+					currentResult = _Internal::MeasureEncodingJob("Base64EncodeString", implementationName, dataSize, settings,
+						[&]() { stringResult = Base64::Encode(data); });
+					currentResult.isVerified = (stringResult == referenceEncoded);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("Base64DecodeString", implementationName, dataSize, settings,
+						[&]() { stringResult = Base64::Decode(referenceEncoded); });
+					currentResult.isVerified = (stringResult == data);
+					results.push_back(currentResult);
+
+					return results;
+				}
+
+				//------------------------------------------------------------------------------
+				// Same cases with Base64, on the hex digest and dump path
+				std::vector<EncodingBenchmarkResult> RunHexString(size_t dataSize, const EncodingBenchmarkSettings &settings)
+				{
+					std::vector<EncodingBenchmarkResult> results;
+
+					const std::string data(_Internal::MakeBenchmarkData(dataSize, settings.randomSeed));
+					const uint8_t *dataBytes = reinterpret_cast<const uint8_t *>(data.data());
+					const char *implementationName = HexString::GetImplementationName();
+
+					std::string referenceEncoded(dataSize * 2, '\0');
+					HexString::_Internal::EncodeScalar(&referenceEncoded[0], dataBytes, dataSize, false);
+					std::string referenceCapitalEncoded(dataSize * 2, '\0');
+					HexString::_Internal::EncodeScalar(&referenceCapitalEncoded[0], dataBytes, dataSize, true);
+
+					std::vector<char> encodeBuffer(dataSize * 2 + 1);
+					std::vector<uint8_t> decodeBuffer(dataSize + 1);
+
+					size_t writtenSize = 0;
+					EncodingBenchmarkResult currentResult;
+
+					// Encode
+					currentResult = _Internal::MeasureEncodingJob("HexEncode", implementationName, dataSize, settings,
+						[&]() { writtenSize = HexString::WriteHexString(dataBytes, dataSize, &encodeBuffer[0], encodeBuffer.size(), false); });
+					currentResult.isVerified = (writtenSize == referenceEncoded.length() && memcmp(&encodeBuffer[0], referenceEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("HexEncode", "Scalar", dataSize, settings,
+						[&]() { writtenSize = HexString::_Internal::EncodeScalar(&encodeBuffer[0], dataBytes, dataSize, false); });
+					currentResult.isVerified = (writtenSize == referenceEncoded.length() && memcmp(&encodeBuffer[0], referenceEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("HexCapitalEncode", implementationName, dataSize, settings,
+						[&]() { writtenSize = HexString::WriteHexString(dataBytes, dataSize, &encodeBuffer[0], encodeBuffer.size(), true); });
+					currentResult.isVerified = (writtenSize == referenceCapitalEncoded.length() && memcmp(&encodeBuffer[0], referenceCapitalEncoded.data(), writtenSize) == 0);
+					results.push_back(currentResult);
+
+					// Decode
+					currentResult = _Internal::MeasureEncodingJob("HexDecode", implementationName, dataSize, settings,
+						[&]() { writtenSize = HexString::ParseHexString(referenceEncoded.data(), referenceEncoded.length(), &decodeBuffer[0], decodeBuffer.size()); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("HexDecode", "Scalar", dataSize, settings,
+						[&]() { writtenSize = HexString::_Internal::DecodeScalar(&decodeBuffer[0], referenceEncoded.data(), dataSize); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("HexCapitalDecode", implementationName, dataSize, settings,
+						[&]() { writtenSize = HexString::ParseHexString(referenceCapitalEncoded.data(), referenceCapitalEncoded.length(), &decodeBuffer[0], decodeBuffer.size()); });
+					currentResult.isVerified = (writtenSize == dataSize && memcmp(&decodeBuffer[0], dataBytes, dataSize) == 0);
+					results.push_back(currentResult);
+
+					// String Interface
+					std::string stringResult;
+					currentResult = _Internal::MeasureEncodingJob("HexEncodeString", implementationName, dataSize, settings,
+						[&]() { stringResult = HexString::ToHexString(data); });
+					currentResult.isVerified = (stringResult == referenceEncoded);
+					results.push_back(currentResult);
+
+					currentResult = _Internal::MeasureEncodingJob("HexDecodeString", implementationName, dataSize, settings,
+						[&]() { stringResult = HexString::FromHexString(referenceEncoded); });
+					currentResult.isVerified = (stringResult == data);
+					results.push_back(currentResult);
+
+					return results;
+				}
+
+				//------------------------------------------------------------------------------
+				std::vector<EncodingBenchmarkResult> RunAll(const EncodingBenchmarkSettings &settings)
+				{
+					std::vector<EncodingBenchmarkResult> results;
+
+					for (size_t currentDataSize : settings.dataSizes)
+					{
+						std::vector<EncodingBenchmarkResult> base64Results(RunBase64(currentDataSize, settings));
+						results.insert(results.end(), base64Results.begin(), base64Results.end());
+
+						std::vector<EncodingBenchmarkResult> hexStringResults(RunHexString(currentDataSize, settings));
+						results.insert(results.end(), hexStringResults.begin(), hexStringResults.end());
+					}
+
+					return results;
+				}
+
+				//------------------------------------------------------------------------------
+				// Machine readable output to track regressions
+				std::string ToJSON(const std::vector<EncodingBenchmarkResult> &results)
+				{
+					std::string resultString("{\"suite\":\"LeggieroEncoding\",\"results\":[");
+					char lineBuffer[512];
+
+					for (size_t i = 0; i < results.size(); ++i)
+					{
+						const EncodingBenchmarkResult &currentResult = results[i];
+						snprintf(lineBuffer, sizeof(lineBuffer),
+							"%s\n{\"name\":\"%s\",\"variant\":\"%s\",\"verified\":%s,\"dataSize\":%llu,\"iterations\":%llu,\"elapsedUs\":%.3f,\"MBPerSec\":%.3f}",
+							((i == 0) ? "" : ","), currentResult.name.c_str(), currentResult.variant.c_str(), (currentResult.isVerified ? "true" : "false"),
+							static_cast<unsigned long long>(currentResult.dataSize), static_cast<unsigned long long>(currentResult.iterationCount),
+							currentResult.elapsedMicroseconds, currentResult.megabytesPerSecond);
+						resultString.append(lineBuffer);
+					}
+
+					resultString.append("\n]}\n");
+					return resultString;
+				}
+			}
+		}
+	}
+}
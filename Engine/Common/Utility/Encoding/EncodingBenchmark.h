@@ -0,0 +1,80 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Encoding/EncodingBenchmark.h (Leggiero - Utility)
+//
+// Throughput benchmarks of encoding utilities
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __UTILITY__ENCODING__ENCODING_BENCHMARK_H
+#define __UTILITY__ENCODING__ENCODING_BENCHMARK_H
+
+
+// Standard Library
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Encoding
+		{
+			// Result of a benchmark case
+			struct EncodingBenchmarkResult
+			{
+			public:
+				std::string	name;
+				std::string	variant;
+
+				// Output was same with the portable code path
+				bool		isVerified;
+
+				size_t		dataSize;
+				uint64_t	iterationCount;
+				double		elapsedMicroseconds;
+
+				// Counted by the size of raw (not encoded) data
+				double		megabytesPerSecond;
+
+			public:
+				EncodingBenchmarkResult()
+					: isVerified(false), dataSize(0), iterationCount(0), elapsedMicroseconds(0.0), megabytesPerSecond(0.0)
+				{ }
+			};
+
+
+			// Sizes of benchmark cases
+			struct EncodingBenchmarkSettings
+			{
+			public:
+				std::vector<size_t> dataSizes = { 1024, 64 * 1024, 4 * 1024 * 1024 };
+
+				// Each case repeats until both are satisfied
+				size_t minimumIterationCount = 4;
+				std::chrono::steady_clock::duration minimumRunTime = std::chrono::milliseconds(200);
+
+				uint32_t randomSeed = 0x5eed;
+			};
+
+
+			namespace Benchmark
+			{
+				// Blocks the calling thread while running; should not be run on the game thread
+
+				std::vector<EncodingBenchmarkResult> RunBase64(size_t dataSize, const EncodingBenchmarkSettings &settings);
+				std::vector<EncodingBenchmarkResult> RunHexString(size_t dataSize, const EncodingBenchmarkSettings &settings);
+
+				// Run every case with every data size in the settings
+				std::vector<EncodingBenchmarkResult> RunAll(const EncodingBenchmarkSettings &settings = EncodingBenchmarkSettings());
+
+				// Machine readable output to track regressions
+				std::string ToJSON(const std::vector<EncodingBenchmarkResult> &results);
+			}
+		}
+	}
+}
+
+#endif
@@ -7,6 +7,18 @@
 // My Header
 #include "HexString.h"
 
+// Standard Library
+#include <algorithm>
+
+// External Library
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+	#define _HEX_STRING_USE_SSSE3
+	#include <tmmintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+	#define _HEX_STRING_USE_NEON
+	#include <arm_neon.h>
+#endif
+
 
 namespace Leggiero
 {
@@ -16,6 +28,285 @@ namespace Leggiero
 		{
 			namespace HexString
 			{
+				//////////////////////////////////////////////////////////////////////////////// Code Tables
+
+				namespace _Internal
+				{
+					namespace
+					{
+						constexpr char kLowerDigits[] = "0123456789abcdef";
+						constexpr char kCapitalDigits[] = "0123456789ABCDEF";
+
+						struct EncodeTable
+						{
+							char pairs[256][2];
+						};
+
+						struct DecodeTable
+						{
+							uint8_t values[256];
+						};
+
+						//------------------------------------------------------------------------------
+						constexpr EncodeTable MakeEncodeTable(bool isCapital)
+						{
+							const char *digits = (isCapital ? kCapitalDigits : kLowerDigits);
+							EncodeTable table { };
+							for (int i = 0; i < 256; ++i)
+							{
+								table.pairs[i][0] = digits[i >> 4];
+								table.pairs[i][1] = digits[i & 0x0f];
+							}
+							return table;
+						}
+
+						//------------------------------------------------------------------------------
+						// Characters out of hex digits are read as 0, as Unsafe::ReadOctetHex does
+						constexpr DecodeTable MakeDecodeTable()
+						{
+							DecodeTable table { };
+							for (int i = 0; i < 16; ++i)
+							{
+								table.values[static_cast<uint8_t>(kLowerDigits[i])] = static_cast<uint8_t>(i);
+								table.values[static_cast<uint8_t>(kCapitalDigits[i])] = static_cast<uint8_t>(i);
+							}
+							return table;
+						}
+
+						constexpr EncodeTable kLowerEncodeTable = MakeEncodeTable(false);
+						constexpr EncodeTable kCapitalEncodeTable = MakeEncodeTable(true);
+						constexpr DecodeTable kDecodeTable = MakeDecodeTable();
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Vectorized Blocks
+
+				// Each function processes whole blocks from the start, and returns the processed byte count.
+				// Decoding stops at the first block having a non-hex character, to be handled by the scalar path.
+
+				namespace _Internal
+				{
+					namespace
+					{
+					#if defined(_HEX_STRING_USE_SSSE3)
+
+						//------------------------------------------------------------------------------
+						// 16 bytes to 32 characters per step
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital)
+						{
+							const __m128i kDigitTable = _mm_loadu_si128(reinterpret_cast<const __m128i *>(isCapital ? kCapitalDigits : kLowerDigits));
+							const __m128i kNibbleMask = _mm_set1_epi8(0x0f);
+
+							size_t processedSize = 0;
+							while (dataSize - processedSize >= 16)
+							{
+								__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + processedSize));
+								__m128i highDigits = _mm_shuffle_epi8(kDigitTable, _mm_and_si128(_mm_srli_epi16(bytes, 4), kNibbleMask));
+								__m128i lowDigits = _mm_shuffle_epi8(kDigitTable, _mm_and_si128(bytes, kNibbleMask));
+
+								_mm_storeu_si128(reinterpret_cast<__m128i *>(outBuffer), _mm_unpacklo_epi8(highDigits, lowDigits));
+								_mm_storeu_si128(reinterpret_cast<__m128i *>(outBuffer + 16), _mm_unpackhi_epi8(highDigits, lowDigits));
+								outBuffer += 32;
+								processedSize += 16;
+							}
+							return processedSize;
+						}
+
+						//------------------------------------------------------------------------------
+						// Convert characters to nibble values, and set each lane of the mask when the character is a hex digit
+						inline __m128i ToNibbles(__m128i characters, __m128i &validMask)
+						{
+							__m128i digits = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+							__m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+
+							// Folding case maps only 'A'-'F' and 'a'-'f' into 'a'-'f'
+							__m128i letters = _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+							__m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+
+							validMask = _mm_or_si128(isDigit, isLetter);
+							return _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+						}
+
+						//------------------------------------------------------------------------------
+						// 32 characters to 16 bytes per step
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *hexData, size_t byteCount)
+						{
+							// High nibble * 16 + low nibble, for each pair of lanes
+							const __m128i kPairWeights = _mm_set1_epi16(0x0110);
+
+							size_t processedSize = 0;
+							while (byteCount - processedSize >= 16)
+							{
+								const char *readPosition = hexData + processedSize * 2;
+								__m128i firstValidMask;
+								__m128i secondValidMask;
+								__m128i firstNibbles = ToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(readPosition)), firstValidMask);
+								__m128i secondNibbles = ToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(readPosition + 16)), secondValidMask);
+								if (_mm_movemask_epi8(_mm_and_si128(firstValidMask, secondValidMask)) != 0xffff)
+								{
+									break;
+								}
+
+								__m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(firstNibbles, kPairWeights), _mm_maddubs_epi16(secondNibbles, kPairWeights));
+								_mm_storeu_si128(reinterpret_cast<__m128i *>(outBuffer + processedSize), bytes);
+								processedSize += 16;
+							}
+							return processedSize;
+						}
+
+						constexpr const char *kImplementationName = "SSSE3";
+
+					#elif defined(_HEX_STRING_USE_NEON)
+
+						//------------------------------------------------------------------------------
+						// 16 bytes to 32 characters per step
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital)
+						{
+							const uint8x16_t kDigitTable = vld1q_u8(reinterpret_cast<const uint8_t *>(isCapital ? kCapitalDigits : kLowerDigits));
+							const uint8x16_t kNibbleMask = vdupq_n_u8(0x0f);
+
+							size_t processedSize = 0;
+							while (dataSize - processedSize >= 16)
+							{
+								uint8x16_t bytes = vld1q_u8(data + processedSize);
+								uint8x16x2_t digitPairs;
+								digitPairs.val[0] = vqtbl1q_u8(kDigitTable, vshrq_n_u8(bytes, 4));
+								digitPairs.val[1] = vqtbl1q_u8(kDigitTable, vandq_u8(bytes, kNibbleMask));
+
+								vst2q_u8(reinterpret_cast<uint8_t *>(outBuffer), digitPairs);
+								outBuffer += 32;
+								processedSize += 16;
+							}
+							return processedSize;
+						}
+
+						//------------------------------------------------------------------------------
+						// Convert characters to nibble values, and set each lane of the mask when the character is a hex digit
+						inline uint8x16_t ToNibbles(uint8x16_t characters, uint8x16_t &validMask)
+						{
+							uint8x16_t digits = vsubq_u8(characters, vdupq_n_u8('0'));
+							uint8x16_t isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+
+							// Folding case maps only 'A'-'F' and 'a'-'f' into 'a'-'f'
+							uint8x16_t letters = vsubq_u8(vorrq_u8(characters, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+							uint8x16_t isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+
+							validMask = vorrq_u8(isDigit, isLetter);
+							return vbslq_u8(isDigit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+						}
+
+						//------------------------------------------------------------------------------
+						// 32 characters to 16 bytes per step; de-interleaving load splits high and low digits
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *hexData, size_t byteCount)
+						{
+							size_t processedSize = 0;
+							while (byteCount - processedSize >= 16)
+							{
+								uint8x16x2_t digitPairs = vld2q_u8(reinterpret_cast<const uint8_t *>(hexData + processedSize * 2));
+								uint8x16_t highValidMask;
+								uint8x16_t lowValidMask;
+								uint8x16_t highNibbles = ToNibbles(digitPairs.val[0], highValidMask);
+								uint8x16_t lowNibbles = ToNibbles(digitPairs.val[1], lowValidMask);
+								if (vminvq_u8(vandq_u8(highValidMask, lowValidMask)) != 0xff)
+								{
+									break;
+								}
+
+								vst1q_u8(outBuffer + processedSize, vorrq_u8(vshlq_n_u8(highNibbles, 4), lowNibbles));
+								processedSize += 16;
+							}
+							return processedSize;
+						}
+
+						constexpr const char *kImplementationName = "NEON";
+
+					#else
+
+						//------------------------------------------------------------------------------
+						size_t EncodeBlocks(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital)
+						{
+							(void)outBuffer;
+							(void)data;
+							(void)dataSize;
+							(void)isCapital;
+							return 0;
+						}
+
+						//------------------------------------------------------------------------------
+						size_t DecodeBlocks(uint8_t *outBuffer, const char *hexData, size_t byteCount)
+						{
+							(void)outBuffer;
+							(void)hexData;
+							(void)byteCount;
+							return 0;
+						}
+
+						constexpr const char *kImplementationName = "Scalar";
+
+					#endif
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Codec
+
+				namespace _Internal
+				{
+					//------------------------------------------------------------------------------
+					size_t EncodeScalar(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital)
+					{
+						const EncodeTable &table = (isCapital ? kCapitalEncodeTable : kLowerEncodeTable);
+						for (size_t i = 0; i < dataSize; ++i)
+						{
+							const char *currentPair = table.pairs[data[i]];
+							outBuffer[i * 2] = currentPair[0];
+							outBuffer[i * 2 + 1] = currentPair[1];
+						}
+						return dataSize * 2;
+					}
+
+					//------------------------------------------------------------------------------
+					size_t DecodeScalar(uint8_t *outBuffer, const char *hexData, size_t byteCount)
+					{
+						const uint8_t *characters = reinterpret_cast<const uint8_t *>(hexData);
+						for (size_t i = 0; i < byteCount; ++i)
+						{
+							outBuffer[i] = static_cast<uint8_t>((kDecodeTable.values[characters[i * 2]] << 4) | kDecodeTable.values[characters[i * 2 + 1]]);
+						}
+						return byteCount;
+					}
+
+					namespace
+					{
+						//------------------------------------------------------------------------------
+						void EncodeHex(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital)
+						{
+							size_t blockProcessedSize = EncodeBlocks(outBuffer, data, dataSize, isCapital);
+							EncodeScalar(outBuffer + blockProcessedSize * 2, data + blockProcessedSize, dataSize - blockProcessedSize, isCapital);
+						}
+
+						//------------------------------------------------------------------------------
+						// Blocks with non-hex characters go through the scalar path, and the vectorized path resumes after them
+						void DecodeHex(uint8_t *outBuffer, const char *hexData, size_t byteCount)
+						{
+							constexpr size_t kScalarStepSize = 16;
+
+							size_t processedSize = 0;
+							while (processedSize < byteCount)
+							{
+								processedSize += DecodeBlocks(outBuffer + processedSize, hexData + processedSize * 2, byteCount - processedSize);
+
+								size_t scalarSize = std::min(kScalarStepSize, byteCount - processedSize);
+								processedSize += DecodeScalar(outBuffer + processedSize, hexData + processedSize * 2, scalarSize);
+							}
+						}
+					}
+				}
+
+
+				//////////////////////////////////////////////////////////////////////////////// Interface
+
 				//------------------------------------------------------------------------------
 				std::string ToHexString(const std::string &binaryString, bool isCapital)
 				{
@@ -25,12 +316,8 @@ namespace Leggiero
 				//------------------------------------------------------------------------------
 				std::string ToHexString(const void *dataBuffer, size_t dataLength, bool isCapital)
 				{
-					const uint8_t *byteBuffer = (const uint8_t *)dataBuffer;
 					std::string resultBuffer(dataLength * 2, '\0');
-					for (size_t i = 0; i < dataLength; ++i)
-					{
-						Unsafe::WriteOctetHex(resultBuffer, i * 2, byteBuffer[i], isCapital);
-					}
+					_Internal::EncodeHex(&resultBuffer[0], static_cast<const uint8_t *>(dataBuffer), dataLength, isCapital);
 					return resultBuffer;
 				}
 
@@ -43,7 +330,6 @@ namespace Leggiero
 				//------------------------------------------------------------------------------
 				size_t WriteHexString(const void *dataBuffer, size_t dataLength, char *buffer, size_t bufferLength, bool isCapital)
 				{
-					const uint8_t *byteBuffer = (const uint8_t *)dataBuffer;
 					size_t writingLength = dataLength * 2;
 					if (bufferLength < writingLength)
 					{
@@ -53,11 +339,7 @@ namespace Leggiero
 							--writingLength;
 						}
 					}
-					size_t sourceLength = writingLength / 2;
-					for (size_t i = 0; i < sourceLength; ++i)
-					{
-						Unsafe::WriteOctetHex(buffer, i * 2, byteBuffer[i], isCapital);
-					}
+					_Internal::EncodeHex(buffer, static_cast<const uint8_t *>(dataBuffer), writingLength / 2, isCapital);
 					return writingLength;
 				}
 
@@ -70,12 +352,8 @@ namespace Leggiero
 				//------------------------------------------------------------------------------
 				size_t WriteHexString(const void *dataBuffer, size_t dataLength, std::vector<char> &buffer, bool isCapital)
 				{
-					const uint8_t *byteBuffer = (const uint8_t *)dataBuffer;
 					buffer.resize(dataLength * 2);
-					for (size_t i = 0; i < dataLength; ++i)
-					{
-						Unsafe::WriteOctetHex(buffer, i * 2, byteBuffer[i], isCapital);
-					}
+					_Internal::EncodeHex(buffer.data(), static_cast<const uint8_t *>(dataBuffer), dataLength, isCapital);
 					return buffer.size();
 				}
 
@@ -86,18 +364,11 @@ namespace Leggiero
 				}
 
 				//------------------------------------------------------------------------------
+				// Trailing odd character is ignored
 				std::string FromHexString(const char *stringBuffer, size_t stringLength)
 				{
 					std::string resultBuffer(stringLength / 2, '\0');
-					for (size_t i = 0; i < stringLength; i += 2)
-					{
-						union
-						{
-							uint8_t source;
-							char target;
-						} a = { Unsafe::ReadOctetHex(stringBuffer, i) };
-						resultBuffer[i / 2] = a.target;
-					}
+					_Internal::DecodeHex(reinterpret_cast<uint8_t *>(&resultBuffer[0]), stringBuffer, resultBuffer.length());
 					return resultBuffer;
 				}
 
@@ -110,16 +381,12 @@ namespace Leggiero
 				//------------------------------------------------------------------------------
 				size_t ParseHexString(const char *stringBuffer, size_t stringLength, void *buffer, size_t bufferLength)
 				{
-					uint8_t *byteTargetBuffer = (uint8_t *)buffer;
 					size_t writingLength = stringLength / 2;
 					if (bufferLength < writingLength)
 					{
 						writingLength = bufferLength;
 					}
-					for (size_t i = 0; i < writingLength; ++i)
-					{
-						byteTargetBuffer[i] = Unsafe::ReadOctetHex(stringBuffer, i * 2);
-					}
+					_Internal::DecodeHex(static_cast<uint8_t *>(buffer), stringBuffer, writingLength);
 					return writingLength;
 				}
 
@@ -130,15 +397,19 @@ namespace Leggiero
 				}
 
 				//------------------------------------------------------------------------------
+				// Trailing odd character is ignored
 				size_t ParseHexString(const char *stringBuffer, size_t stringLength, std::vector<uint8_t> &buffer)
 				{
 					buffer.resize(stringLength / 2);
-					for (size_t i = 0; i < stringLength; i += 2)
-					{
-						buffer[i / 2] = Unsafe::ReadOctetHex(stringBuffer, i);
-					}
+					_Internal::DecodeHex(buffer.data(), stringBuffer, buffer.size());
 					return buffer.size();
 				}
+
+				//------------------------------------------------------------------------------
+				const char *GetImplementationName()
+				{
+					return _Internal::kImplementationName;
+				}
 			}
 		}
 	}
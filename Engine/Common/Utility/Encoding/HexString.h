@@ -44,13 +44,25 @@ namespace Leggiero
 				size_t ParseHexString(const std::string &hexString, std::vector<uint8_t> &buffer);
 				size_t ParseHexString(const char *stringBuffer, size_t stringLength, std::vector<uint8_t> &buffer);
 
+				// Name of the vectorized code path compiled in: "SSSE3", "NEON", or "Scalar"
+				const char *GetImplementationName();
+
+				namespace _Internal
+				{
+					// Portable code paths, for verification and benchmark of the vectorized ones
+					// Decoding reads byteCount * 2 characters, and characters out of hex digits are read as 0.
+					size_t EncodeScalar(char *outBuffer, const uint8_t *data, size_t dataSize, bool isCapital);
+					size_t DecodeScalar(uint8_t *outBuffer, const char *hexData, size_t byteCount);
+				}
+
 				// Un-safe hex manipulation utilites
+				// Byte-at-a-time; bulk conversion should use the functions above
 				class Unsafe
 				{
 				public:
 					// Hope to faster than sprintf
 					template <typename BufType>
-					static void WriteOctetHex(BufType buf, size_t bufOffset, uint8_t hextData, bool isCapital)
+					static void WriteOctetHex(BufType &&buf, size_t bufOffset, uint8_t hextData, bool isCapital)
 					{
 						switch (hextData)
 						{
@@ -408,31 +420,13 @@ namespace Leggiero
 				template <size_t DATA_LENGTH>
 				inline std::string GetFixedLengthHexString(const std::string &binaryString, bool isCapital = false)
 				{
-					char hexCString[DATA_LENGTH * 2 + 1];
-					for (size_t i = 0; i < DATA_LENGTH; ++i)
-					{
-						union
-						{
-							char source;
-							uint8_t target;
-						} a = { binaryString[i] };
-						Unsafe::WriteOctetHex(hexCString, i * 2, a.target, isCapital);
-					}
-					hexCString[DATA_LENGTH * 2] = '\0';
-					return hexCString;
+					return ToHexString(binaryString.c_str(), DATA_LENGTH, isCapital);
 				}
 
 				template <size_t DATA_LENGTH>
 				inline std::string GetFixedLengthHexString(const void *dataBuffer, bool isCapital = false)
 				{
-					char hexCString[DATA_LENGTH * 2 + 1];
-					const uint8_t *byteBuffer = (const uint8_t *)dataBuffer;
-					for (size_t i = 0; i < DATA_LENGTH; ++i)
-					{
-						Unsafe::WriteOctetHex(hexCString, i * 2, byteBuffer[i], isCapital);
-					}
-					hexCString[DATA_LENGTH * 2] = '\0';
-					return hexCString;
+					return ToHexString(dataBuffer, DATA_LENGTH, isCapital);
 				}
 			}
 		}
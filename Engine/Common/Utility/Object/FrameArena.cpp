@@ -0,0 +1,186 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Object/FrameArena.cpp (Leggiero - Utility)
+//
+// Frame Arena Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "FrameArena.h"
+
+// Standard Library
+#include <algorithm>
+#include <new>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Object
+		{
+			//////////////////////////////////////////////////////////////////////////////// FrameArena
+
+			//------------------------------------------------------------------------------
+			FrameArena::FrameArena(size_t chunkSize)
+				: m_chunkSize(std::max(chunkSize, static_cast<size_t>(256)))
+				, m_firstChunk(nullptr), m_currentChunk(nullptr), m_currentOffset(0)
+				, m_usedBytes(0), m_highWaterBytes(0), m_reservedBytes(0)
+			{
+			}
+
+			//------------------------------------------------------------------------------
+			FrameArena::~FrameArena()
+			{
+				_Chunk *chunkToFree = m_firstChunk;
+				while (chunkToFree != nullptr)
+				{
+					_Chunk *nextChunk = chunkToFree->next;
+					::operator delete(chunkToFree);
+					chunkToFree = nextChunk;
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			// Allocate memory block from the arena
+			// alignment should be a power of 2
+			void *FrameArena::Allocate(size_t size, size_t alignment)
+			{
+				if (m_currentChunk != nullptr)
+				{
+					uintptr_t dataBase = reinterpret_cast<uintptr_t>(m_currentChunk->GetData());
+					uintptr_t alignedStart = (dataBase + m_currentOffset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+					size_t newOffset = static_cast<size_t>(alignedStart - dataBase) + size;
+					if (newOffset <= m_currentChunk->capacity)
+					{
+						m_usedBytes += (newOffset - m_currentOffset);
+						m_currentOffset = newOffset;
+						if (m_usedBytes > m_highWaterBytes)
+						{
+							m_highWaterBytes = m_usedBytes;
+						}
+						return reinterpret_cast<void *>(alignedStart);
+					}
+				}
+
+				return _AllocateInNextChunk(size, alignment);
+			}
+
+			//------------------------------------------------------------------------------
+			bool FrameArena::TryRollback(void *ptr, size_t size)
+			{
+				if (m_currentChunk == nullptr || ptr == nullptr)
+				{
+					return false;
+				}
+
+				uint8_t *blockStart = static_cast<uint8_t *>(ptr);
+				uint8_t *chunkData = m_currentChunk->GetData();
+				if (blockStart < chunkData || blockStart + size != chunkData + m_currentOffset)
+				{
+					return false;
+				}
+
+				m_currentOffset -= size;
+				m_usedBytes -= size;
+				return true;
+			}
+
+			//------------------------------------------------------------------------------
+			void FrameArena::Reset()
+			{
+				m_currentChunk = m_firstChunk;
+				m_currentOffset = 0;
+				m_usedBytes = 0;
+			}
+
+			//------------------------------------------------------------------------------
+			FrameArena::Marker FrameArena::GetMarker() const
+			{
+				Marker currentMarker;
+				currentMarker.chunk = m_currentChunk;
+				currentMarker.offset = m_currentOffset;
+				currentMarker.usedBytes = m_usedBytes;
+				return currentMarker;
+			}
+
+			//------------------------------------------------------------------------------
+			void FrameArena::RewindTo(const Marker &marker)
+			{
+				if (marker.chunk == nullptr)
+				{
+					Reset();
+					return;
+				}
+
+				m_currentChunk = marker.chunk;
+				m_currentOffset = marker.offset;
+				m_usedBytes = marker.usedBytes;
+			}
+
+			//------------------------------------------------------------------------------
+			void FrameArena::TrimUnusedChunks()
+			{
+				_Chunk *lastChunkToKeep = ((m_currentChunk != nullptr) ? m_currentChunk : m_firstChunk);
+				if (lastChunkToKeep == nullptr)
+				{
+					return;
+				}
+
+				_Chunk *chunkToFree = lastChunkToKeep->next;
+				lastChunkToKeep->next = nullptr;
+				while (chunkToFree != nullptr)
+				{
+					_Chunk *nextChunk = chunkToFree->next;
+					m_reservedBytes -= chunkToFree->capacity;
+					::operator delete(chunkToFree);
+					chunkToFree = nextChunk;
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			FrameArena &FrameArena::GetThreadArena()
+			{
+				static thread_local FrameArena s_threadArena;
+				return s_threadArena;
+			}
+
+			//------------------------------------------------------------------------------
+			// Move to the next chunk, inserting a new one when the next is missing or too small
+			void *FrameArena::_AllocateInNextChunk(size_t size, size_t alignment)
+			{
+				size_t requiredCapacity = size + alignment;
+
+				_Chunk *nextChunk = ((m_currentChunk != nullptr) ? m_currentChunk->next : m_firstChunk);
+				if (nextChunk == nullptr || nextChunk->capacity < requiredCapacity)
+				{
+					_Chunk *createdChunk = _CreateChunk(std::max(m_chunkSize, requiredCapacity));
+					createdChunk->next = nextChunk;
+					if (m_currentChunk != nullptr)
+					{
+						m_currentChunk->next = createdChunk;
+					}
+					else
+					{
+						m_firstChunk = createdChunk;
+					}
+					nextChunk = createdChunk;
+				}
+
+				m_currentChunk = nextChunk;
+				m_currentOffset = 0;
+
+				return Allocate(size, alignment);
+			}
+
+			//------------------------------------------------------------------------------
+			FrameArena::_Chunk *FrameArena::_CreateChunk(size_t capacity)
+			{
+				_Chunk *createdChunk = static_cast<_Chunk *>(::operator new(sizeof(_Chunk) + capacity));
+				createdChunk->next = nullptr;
+				createdChunk->capacity = capacity;
+				m_reservedBytes += capacity;
+				return createdChunk;
+			}
+		}
+	}
+}
@@ -0,0 +1,167 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Object/FrameArena.h (Leggiero - Utility)
+//
+// Linear Arena Allocator for Frame-Transient Data
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __UTILITY__OBJECT__FRAME_ARENA_H
+#define __UTILITY__OBJECT__FRAME_ARENA_H
+
+
+// Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Leggiero.Utility
+#include "../Sugar/NonCopyable.h"
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Object
+		{
+			// Bump allocator for data living no longer than a frame
+			// Memory is taken from chunks kept over resets, so a warmed-up arena does not touch the heap.
+			// Not thread-safe: each thread should use its own arena (see GetThreadArena).
+			class FrameArena
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+			protected:
+				struct _Chunk
+				{
+					_Chunk	*next;
+					size_t	capacity;
+
+					uint8_t *GetData() { return reinterpret_cast<uint8_t *>(this + 1); }
+				};
+
+			public:
+				// Position in the arena to rewind to
+				struct Marker
+				{
+				public:
+					Marker() : chunk(nullptr), offset(0), usedBytes(0) { }
+
+				protected:
+					friend class FrameArena;
+
+					_Chunk	*chunk;
+					size_t	offset;
+					size_t	usedBytes;
+				};
+
+			public:
+				FrameArena(size_t chunkSize = kDefaultChunkSize);
+				~FrameArena();
+
+			public:
+				void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+				template <typename T>
+				T *AllocateArray(size_t count) { return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T))); }
+
+				// Give back the block only when it is the last allocation; otherwise it is kept until rewind or reset
+				bool TryRollback(void *ptr, size_t size);
+
+				// Release every allocation at once, keeping chunks for reuse
+				void Reset();
+
+				Marker GetMarker() const;
+				void RewindTo(const Marker &marker);
+
+				// Free chunks not needed by the current allocations, except the first one
+				void TrimUnusedChunks();
+
+			public:
+				size_t GetUsedBytes() const { return m_usedBytes; }
+				size_t GetHighWaterBytes() const { return m_highWaterBytes; }
+				size_t GetReservedBytes() const { return m_reservedBytes; }
+				size_t GetChunkSize() const { return m_chunkSize; }
+
+				void ResetHighWater() { m_highWaterBytes = m_usedBytes; }
+
+			public:
+				// Arena dedicated to the calling thread
+				static FrameArena &GetThreadArena();
+
+			protected:
+				void *_AllocateInNextChunk(size_t size, size_t alignment);
+				_Chunk *_CreateChunk(size_t capacity);
+
+			protected:
+				size_t	m_chunkSize;
+
+				_Chunk	*m_firstChunk;
+				_Chunk	*m_currentChunk;
+				size_t	m_currentOffset;
+
+				size_t	m_usedBytes;
+				size_t	m_highWaterBytes;
+				size_t	m_reservedBytes;
+			};
+
+
+			// Rewind the arena to where it was when the scope began
+			class FrameArenaScope
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				FrameArenaScope() : m_arena(FrameArena::GetThreadArena()), m_marker(m_arena.GetMarker()) { }
+				explicit FrameArenaScope(FrameArena &arena) : m_arena(arena), m_marker(arena.GetMarker()) { }
+				~FrameArenaScope() { m_arena.RewindTo(m_marker); }
+
+			public:
+				FrameArena &GetArena() { return m_arena; }
+
+			protected:
+				FrameArena			&m_arena;
+				FrameArena::Marker	m_marker;
+			};
+
+
+			// STL allocator adapter on a frame arena
+			// Containers using it must not outlive the rewind or reset of the arena.
+			template <typename T>
+			class FrameArenaAllocator
+			{
+			public:
+				using value_type = T;
+
+			public:
+				FrameArenaAllocator() noexcept : m_arena(&FrameArena::GetThreadArena()) { }
+				explicit FrameArenaAllocator(FrameArena &arena) noexcept : m_arena(&arena) { }
+
+				template <typename U>
+				FrameArenaAllocator(const FrameArenaAllocator<U> &other) noexcept : m_arena(other.GetArena()) { }
+
+			public:
+				T *allocate(size_t n) { return m_arena->AllocateArray<T>(n); }
+				void deallocate(T *p, size_t n) noexcept { m_arena->TryRollback(p, sizeof(T) * n); }
+
+			public:
+				FrameArena *GetArena() const noexcept { return m_arena; }
+
+			protected:
+				FrameArena	*m_arena;
+			};
+
+			template <typename T, typename U>
+			bool operator==(const FrameArenaAllocator<T> &lhs, const FrameArenaAllocator<U> &rhs) noexcept { return (lhs.GetArena() == rhs.GetArena()); }
+
+			template <typename T, typename U>
+			bool operator!=(const FrameArenaAllocator<T> &lhs, const FrameArenaAllocator<U> &rhs) noexcept { return (lhs.GetArena() != rhs.GetArena()); }
+
+
+			template <typename T>
+			using FrameArenaVector = std::vector<T, FrameArenaAllocator<T> >;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,505 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Object/ObjectPool.h (Leggiero - Utility)
+//
+// Bounded Object Pools with Per-Thread Cache
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __UTILITY__OBJECT__OBJECT_POOL_H
+#define __UTILITY__OBJECT__OBJECT_POOL_H
+
+
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Leggiero.Utility
+#include "../Sugar/NonCopyable.h"
+#include "../Threading/ManagedThreadPrimitives.h"
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Object
+		{
+			namespace _Internal
+			{
+				// Free list of pooled entries: each thread works on its own cache, and spills to or refills from a shared overflow by batch
+				// Objects left in caches of other threads are not trimmed, but they are bounded by the thread cache size.
+				template <typename EntryT>
+				class ThreadCachingFreeList
+					: public SyntacticSugar::NonCopyable
+				{
+				public:
+					ThreadCachingFreeList(size_t capacity, size_t threadCacheSize)
+						: m_core(std::make_shared<_Core>(capacity, std::max(threadCacheSize, static_cast<size_t>(2))))
+					{ }
+
+					~ThreadCachingFreeList()
+					{
+						// Caches of other threads are freed when they find this list gone
+						_ThreadCacheTable *cacheTable = _GetThreadCacheTable();
+						if (cacheTable == nullptr)
+						{
+							return;
+						}
+						for (typename std::vector<_ThreadCache>::iterator it = cacheTable->caches.begin(); it != cacheTable->caches.end(); ++it)
+						{
+							if (it->serial == m_core->serial)
+							{
+								cacheTable->caches.erase(it);
+								break;
+							}
+						}
+					}
+
+				public:
+					bool TryPop(EntryT &outEntry)
+					{
+						std::vector<EntryT> *threadCache = _GetThreadCache();
+						if (threadCache == nullptr)
+						{
+							// Thread is finishing; work on the overflow directly
+							Threading::ScopedSpinMutexLock lockContext(m_core->overflowLock);
+							if (m_core->overflow.empty())
+							{
+								return false;
+							}
+							outEntry = std::move(m_core->overflow.back());
+							m_core->overflow.pop_back();
+							m_core->pooledCount.fetch_sub(1, std::memory_order_relaxed);
+							return true;
+						}
+
+						if (threadCache->empty())
+						{
+							Threading::ScopedSpinMutexLock lockContext(m_core->overflowLock);
+							size_t refillCount = std::min(m_core->overflow.size(), m_core->threadCacheSize / 2);
+							if (refillCount == 0)
+							{
+								return false;
+							}
+							std::move(m_core->overflow.end() - refillCount, m_core->overflow.end(), std::back_inserter(*threadCache));
+							m_core->overflow.erase(m_core->overflow.end() - refillCount, m_core->overflow.end());
+						}
+
+						outEntry = std::move(threadCache->back());
+						threadCache->pop_back();
+						m_core->pooledCount.fetch_sub(1, std::memory_order_relaxed);
+						return true;
+					}
+
+					// Returns false without taking the entry when the pool is full
+					bool TryPush(EntryT &entry)
+					{
+						if (m_core->pooledCount.fetch_add(1, std::memory_order_relaxed) >= m_core->capacity.load(std::memory_order_relaxed))
+						{
+							m_core->pooledCount.fetch_sub(1, std::memory_order_relaxed);
+							return false;
+						}
+
+						std::vector<EntryT> *threadCache = _GetThreadCache();
+						if (threadCache == nullptr)
+						{
+							Threading::ScopedSpinMutexLock lockContext(m_core->overflowLock);
+							m_core->overflow.push_back(std::move(entry));
+							return true;
+						}
+
+						threadCache->push_back(std::move(entry));
+						if (threadCache->size() > m_core->threadCacheSize)
+						{
+							size_t spillCount = threadCache->size() / 2;
+							Threading::ScopedSpinMutexLock lockContext(m_core->overflowLock);
+							std::move(threadCache->end() - spillCount, threadCache->end(), std::back_inserter(m_core->overflow));
+							threadCache->erase(threadCache->end() - spillCount, threadCache->end());
+						}
+						return true;
+					}
+
+					// Free pooled entries down to keepCount
+					void Trim(size_t keepCount)
+					{
+						std::vector<EntryT> entriesToFree;
+
+						std::vector<EntryT> *threadCache = _GetThreadCache();
+						{
+							Threading::ScopedSpinMutexLock lockContext(m_core->overflowLock);
+							if (threadCache != nullptr)
+							{
+								std::move(threadCache->begin(), threadCache->end(), std::back_inserter(m_core->overflow));
+								threadCache->clear();
+							}
+
+							size_t pooledCount = m_core->pooledCount.load(std::memory_order_relaxed);
+							size_t freeCount = ((pooledCount > keepCount) ? std::min(pooledCount - keepCount, m_core->overflow.size()) : 0);
+							if (freeCount > 0)
+							{
+								std::move(m_core->overflow.end() - freeCount, m_core->overflow.end(), std::back_inserter(entriesToFree));
+								m_core->overflow.erase(m_core->overflow.end() - freeCount, m_core->overflow.end());
+								m_core->pooledCount.fetch_sub(freeCount, std::memory_order_relaxed);
+							}
+							if (m_core->overflow.empty())
+							{
+								std::vector<EntryT>().swap(m_core->overflow);
+							}
+						}
+
+						// Entries are destroyed here, out of the lock
+					}
+
+					void SetCapacity(size_t capacity) { m_core->capacity.store(capacity, std::memory_order_relaxed); }
+					size_t GetCapacity() const { return m_core->capacity.load(std::memory_order_relaxed); }
+					size_t GetPooledCount() const { return m_core->pooledCount.load(std::memory_order_relaxed); }
+
+				protected:
+					struct _Core
+					{
+					public:
+						_Core(size_t capacity, size_t threadCacheSize)
+							: serial(ms_serialIssuer.fetch_add(1, std::memory_order_relaxed)), threadCacheSize(threadCacheSize), capacity(capacity), pooledCount(0)
+						{ }
+
+					public:
+						const uint64_t	serial;
+						const size_t	threadCacheSize;
+
+						std::atomic<size_t>	capacity;
+						std::atomic<size_t>	pooledCount;
+
+						Threading::AdaptiveSpinMutex	overflowLock;
+						std::vector<EntryT>				overflow;
+
+					protected:
+						static std::atomic<uint64_t> ms_serialIssuer;
+					};
+
+					struct _ThreadCache
+					{
+						uint64_t				serial;
+						std::weak_ptr<_Core>	core;
+						std::vector<EntryT>		entries;
+					};
+
+					struct _ThreadCacheTable
+					{
+					public:
+						_ThreadCacheTable() { _GetThreadCacheTableState() = kTableAlive; }
+
+						~_ThreadCacheTable()
+						{
+							_GetThreadCacheTableState() = kTableDestroyed;
+
+							// Give cached entries back when the thread finishes
+							for (_ThreadCache &currentCache : caches)
+							{
+								std::shared_ptr<_Core> currentCore(currentCache.core.lock());
+								if (currentCore && !currentCache.entries.empty())
+								{
+									Threading::ScopedSpinMutexLock lockContext(currentCore->overflowLock);
+									std::move(currentCache.entries.begin(), currentCache.entries.end(), std::back_inserter(currentCore->overflow));
+								}
+							}
+						}
+
+					public:
+						std::vector<_ThreadCache> caches;
+					};
+
+				protected:
+					static constexpr int kTableNotCreated = 0;
+					static constexpr int kTableAlive = 1;
+					static constexpr int kTableDestroyed = 2;
+
+					// Trivial thread local, safe to read even while the thread is finishing
+					static int &_GetThreadCacheTableState()
+					{
+						static thread_local int s_tableState = kTableNotCreated;
+						return s_tableState;
+					}
+
+					// nullptr when the table is already destroyed, e.g. in static destruction after the thread's exit
+					static _ThreadCacheTable *_GetThreadCacheTable()
+					{
+						if (_GetThreadCacheTableState() == kTableDestroyed)
+						{
+							return nullptr;
+						}
+						static thread_local _ThreadCacheTable s_cacheTable;
+						return &s_cacheTable;
+					}
+
+					std::vector<EntryT> *_GetThreadCache()
+					{
+						_ThreadCacheTable *cacheTable = _GetThreadCacheTable();
+						if (cacheTable == nullptr)
+						{
+							return nullptr;
+						}
+
+						for (_ThreadCache &currentCache : cacheTable->caches)
+						{
+							if (currentCache.serial == m_core->serial)
+							{
+								return &currentCache.entries;
+							}
+						}
+
+						// First use in this thread: sweep caches of lists already gone
+						cacheTable->caches.erase(
+							std::remove_if(cacheTable->caches.begin(), cacheTable->caches.end(), [](const _ThreadCache &currentCache) { return currentCache.core.expired(); }),
+							cacheTable->caches.end());
+
+						cacheTable->caches.push_back(_ThreadCache { m_core->serial, m_core, std::vector<EntryT>() });
+						cacheTable->caches.back().entries.reserve(m_core->threadCacheSize + 1);
+						return &cacheTable->caches.back().entries;
+					}
+
+				protected:
+					std::shared_ptr<_Core> m_core;
+				};
+
+				template <typename EntryT>
+				std::atomic<uint64_t> ThreadCachingFreeList<EntryT>::_Core::ms_serialIssuer(1);
+			}
+
+
+			// Bounded Object Pool
+			// Objects are handed out by a move-only handle, which gives the object back to the pool when destroyed.
+			// The pool should outlive all of its handles.
+			template <typename ObjectT>
+			class ObjectPool
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				using ObjectType = ObjectT;
+
+				// Called when an object is given back, before it is pooled
+				using ResetFuncType = std::function<void(ObjectT &)>;
+
+				// Makes a new object when the pool is empty; returning nullptr means no creation
+				using CreateFuncType = std::function<ObjectT *()>;
+
+				static constexpr size_t kDefaultCapacity = 256;
+				static constexpr size_t kDefaultThreadCacheSize = 32;
+
+			public:
+				// Handle to a pooled object
+				class Handle
+				{
+				public:
+					Handle() : m_pool(nullptr), m_object(nullptr) { }
+					Handle(ObjectPool *pool, ObjectT *object) : m_pool(pool), m_object(object) { }
+					~Handle() { Reset(); }
+
+					Handle(const Handle &other) = delete;
+					Handle &operator=(const Handle &other) = delete;
+
+					Handle(Handle &&other) noexcept
+						: m_pool(other.m_pool), m_object(other.m_object)
+					{
+						other.m_pool = nullptr;
+						other.m_object = nullptr;
+					}
+
+					Handle &operator=(Handle &&other) noexcept
+					{
+						if (this != &other)
+						{
+							Reset();
+							m_pool = other.m_pool;
+							m_object = other.m_object;
+							other.m_pool = nullptr;
+							other.m_object = nullptr;
+						}
+						return *this;
+					}
+
+				public:
+					ObjectT *Get() const { return m_object; }
+					ObjectT *operator->() const { return m_object; }
+					ObjectT &operator*() const { return *m_object; }
+					explicit operator bool() const { return (m_object != nullptr); }
+
+					// Give the object back to the pool now
+					void Reset()
+					{
+						if (m_object != nullptr)
+						{
+							m_pool->ReleaseRawObject(m_object);
+							m_object = nullptr;
+						}
+					}
+
+					// Take the object out of the handle; caller should release it by ReleaseRawObject
+					ObjectT *Detach()
+					{
+						ObjectT *detachedObject = m_object;
+						m_object = nullptr;
+						return detachedObject;
+					}
+
+				protected:
+					ObjectPool	*m_pool;
+					ObjectT		*m_object;
+				};
+
+			public:
+				ObjectPool(size_t capacity = kDefaultCapacity, ResetFuncType resetFunc = nullptr, CreateFuncType createFunc = nullptr, size_t threadCacheSize = kDefaultThreadCacheSize)
+					: m_freeList(capacity, threadCacheSize), m_resetFunc(resetFunc), m_createFunc(createFunc)
+				{ }
+
+			public:
+				Handle GetObject() { return Handle(this, GetRawObject()); }
+
+				ObjectT *GetRawObject()
+				{
+					std::unique_ptr<ObjectT> pooledObject;
+					if (m_freeList.TryPop(pooledObject))
+					{
+						return pooledObject.release();
+					}
+					return _CreateObject();
+				}
+
+				void ReleaseRawObject(ObjectT *obj)
+				{
+					if (obj == nullptr)
+					{
+						return;
+					}
+
+					std::unique_ptr<ObjectT> objectToPool(obj);
+					if (m_resetFunc)
+					{
+						m_resetFunc(*objectToPool);
+					}
+					m_freeList.TryPush(objectToPool);
+				}
+
+			public:
+				void SetCapacity(size_t capacity) { m_freeList.SetCapacity(capacity); }
+				size_t GetCapacity() const { return m_freeList.GetCapacity(); }
+				size_t GetPooledCount() const { return m_freeList.GetPooledCount(); }
+
+				// Free pooled objects, e.g. on memory warning
+				void Trim(size_t keepCount = 0) { m_freeList.Trim(keepCount); }
+				void Clear() { m_freeList.Trim(0); }
+
+			protected:
+				ObjectT *_CreateObject()
+				{
+					if (m_createFunc)
+					{
+						return m_createFunc();
+					}
+					if constexpr (std::is_default_constructible<ObjectT>::value)
+					{
+						return new ObjectT();
+					}
+					else
+					{
+						return nullptr;
+					}
+				}
+
+			protected:
+				_Internal::ThreadCachingFreeList<std::unique_ptr<ObjectT> > m_freeList;
+
+				ResetFuncType	m_resetFunc;
+				CreateFuncType	m_createFunc;
+			};
+
+
+			// Bounded Pool of Shared Objects
+			// For objects which need shared ownership; pooling keeps the shared_ptr control block too.
+			// Releasing caller should make sure that nobody else keeps using the object.
+			template <typename ObjectT>
+			class SharedObjectPool
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				using ObjectType = ObjectT;
+				using ObjectHandleType = std::shared_ptr<ObjectT>;
+
+				using ResetFuncType = std::function<void(ObjectT &)>;
+				using CreateFuncType = std::function<std::shared_ptr<ObjectT>()>;
+
+				static constexpr size_t kDefaultCapacity = 256;
+				static constexpr size_t kDefaultThreadCacheSize = 32;
+
+			public:
+				SharedObjectPool(size_t capacity = kDefaultCapacity, ResetFuncType resetFunc = nullptr, CreateFuncType createFunc = nullptr, size_t threadCacheSize = kDefaultThreadCacheSize)
+					: m_freeList(capacity, threadCacheSize), m_resetFunc(resetFunc), m_createFunc(createFunc)
+				{ }
+
+			public:
+				ObjectHandleType GetObject()
+				{
+					ObjectHandleType pooledObject;
+					if (m_freeList.TryPop(pooledObject))
+					{
+						return pooledObject;
+					}
+					return _CreateObject();
+				}
+
+				void ReleaseObject(ObjectHandleType obj)
+				{
+					if (!obj)
+					{
+						return;
+					}
+
+					if (m_resetFunc)
+					{
+						m_resetFunc(*obj);
+					}
+					m_freeList.TryPush(obj);
+				}
+
+			public:
+				void SetCapacity(size_t capacity) { m_freeList.SetCapacity(capacity); }
+				size_t GetCapacity() const { return m_freeList.GetCapacity(); }
+				size_t GetPooledCount() const { return m_freeList.GetPooledCount(); }
+
+				void Trim(size_t keepCount = 0) { m_freeList.Trim(keepCount); }
+				void Clear() { m_freeList.Trim(0); }
+
+			protected:
+				ObjectHandleType _CreateObject()
+				{
+					if (m_createFunc)
+					{
+						return m_createFunc();
+					}
+					if constexpr (std::is_default_constructible<ObjectT>::value)
+					{
+						return std::make_shared<ObjectT>();
+					}
+					else
+					{
+						return nullptr;
+					}
+				}
+
+			protected:
+				_Internal::ThreadCachingFreeList<ObjectHandleType> m_freeList;
+
+				ResetFuncType	m_resetFunc;
+				CreateFuncType	m_createFunc;
+			};
+		}
+	}
+}
+
+#endif
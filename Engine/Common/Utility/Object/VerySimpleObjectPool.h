@@ -22,6 +22,7 @@ namespace Leggiero
 		namespace Object
 		{
 			// Very Simple Object Cache Pool
+			// Unbounded; prefer ObjectPool or SharedObjectPool in ObjectPool.h for new code
 			template <typename ObjectT>
 			class VerySimpleObjectPool
 			{
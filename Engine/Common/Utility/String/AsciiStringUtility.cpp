@@ -8,9 +8,20 @@
 #include "AsciiStringUtility.h"
 
 // Standard Library
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <unordered_set>
 
+// External Library
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define _ASCII_STRING_USE_SSE2
+	#include <emmintrin.h>
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+	#define _ASCII_STRING_USE_NEON
+	#include <arm_neon.h>
+#endif
+
 
 namespace Leggiero
 {
@@ -18,6 +29,200 @@ namespace Leggiero
 	{
 		namespace String
 		{
+			//////////////////////////////////////////////////////////////////////////////// Case Tables
+
+			namespace _Internal
+			{
+				namespace
+				{
+					struct CaseTable
+					{
+						char values[256];
+					};
+
+					//------------------------------------------------------------------------------
+					constexpr CaseTable MakeCaseTable(bool isToUpper)
+					{
+						CaseTable table { };
+						for (int i = 0; i < 256; ++i)
+						{
+							table.values[i] = static_cast<char>(i);
+						}
+						for (int i = 0; i < 26; ++i)
+						{
+							if (isToUpper)
+							{
+								table.values['a' + i] = static_cast<char>('A' + i);
+							}
+							else
+							{
+								table.values['A' + i] = static_cast<char>('a' + i);
+							}
+						}
+						return table;
+					}
+
+					constexpr CaseTable kToLowerTable = MakeCaseTable(false);
+					constexpr CaseTable kToUpperTable = MakeCaseTable(true);
+
+					//------------------------------------------------------------------------------
+					inline char ToLowerCharacter(char character)
+					{
+						return kToLowerTable.values[static_cast<uint8_t>(character)];
+					}
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Vectorized Blocks
+
+			// Each function processes whole 16 characters blocks from the start, and returns the processed length.
+
+			namespace _Internal
+			{
+				namespace
+				{
+				#if defined(_ASCII_STRING_USE_SSE2)
+
+					//------------------------------------------------------------------------------
+					// Set lanes of characters in [rangeStart, rangeStart + 26)
+					inline __m128i MaskLetters(__m128i characters, char rangeStart)
+					{
+						// Biased to compare unsigned distances with signed comparison
+						__m128i biasedDistances = _mm_sub_epi8(characters, _mm_set1_epi8(static_cast<char>(rangeStart - 128)));
+						return _mm_cmplt_epi8(biasedDistances, _mm_set1_epi8(-128 + 26));
+					}
+
+					//------------------------------------------------------------------------------
+					size_t ConvertCaseBlocks(char *buffer, size_t length, bool isToUpper)
+					{
+						const char kRangeStart = (isToUpper ? 'a' : 'A');
+						const __m128i kCaseBit = _mm_set1_epi8(0x20);
+
+						size_t processedLength = 0;
+						while (length - processedLength >= 16)
+						{
+							__m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i *>(buffer + processedLength));
+							characters = _mm_xor_si128(characters, _mm_and_si128(MaskLetters(characters, kRangeStart), kCaseBit));
+							_mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + processedLength), characters);
+							processedLength += 16;
+						}
+						return processedLength;
+					}
+
+					//------------------------------------------------------------------------------
+					// Stops at the first block having a difference
+					size_t MatchNonCaseSensitiveBlocks(const char *string1, const char *string2, size_t length)
+					{
+						const __m128i kCaseBit = _mm_set1_epi8(0x20);
+
+						size_t processedLength = 0;
+						while (length - processedLength >= 16)
+						{
+							__m128i characters1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(string1 + processedLength));
+							__m128i characters2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(string2 + processedLength));
+							characters1 = _mm_or_si128(characters1, _mm_and_si128(MaskLetters(characters1, 'A'), kCaseBit));
+							characters2 = _mm_or_si128(characters2, _mm_and_si128(MaskLetters(characters2, 'A'), kCaseBit));
+							if (_mm_movemask_epi8(_mm_cmpeq_epi8(characters1, characters2)) != 0xffff)
+							{
+								break;
+							}
+							processedLength += 16;
+						}
+						return processedLength;
+					}
+
+				#elif defined(_ASCII_STRING_USE_NEON)
+
+					//------------------------------------------------------------------------------
+					// Set lanes of characters in [rangeStart, rangeStart + 26)
+					inline uint8x16_t MaskLetters(uint8x16_t characters, char rangeStart)
+					{
+						return vcltq_u8(vsubq_u8(characters, vdupq_n_u8(static_cast<uint8_t>(rangeStart))), vdupq_n_u8(26));
+					}
+
+					//------------------------------------------------------------------------------
+					size_t ConvertCaseBlocks(char *buffer, size_t length, bool isToUpper)
+					{
+						const char kRangeStart = (isToUpper ? 'a' : 'A');
+						const uint8x16_t kCaseBit = vdupq_n_u8(0x20);
+
+						size_t processedLength = 0;
+						while (length - processedLength >= 16)
+						{
+							uint8_t *blockPosition = reinterpret_cast<uint8_t *>(buffer + processedLength);
+							uint8x16_t characters = vld1q_u8(blockPosition);
+							vst1q_u8(blockPosition, veorq_u8(characters, vandq_u8(MaskLetters(characters, kRangeStart), kCaseBit)));
+							processedLength += 16;
+						}
+						return processedLength;
+					}
+
+					//------------------------------------------------------------------------------
+					// Stops at the first block having a difference
+					size_t MatchNonCaseSensitiveBlocks(const char *string1, const char *string2, size_t length)
+					{
+						const uint8x16_t kCaseBit = vdupq_n_u8(0x20);
+
+						size_t processedLength = 0;
+						while (length - processedLength >= 16)
+						{
+							uint8x16_t characters1 = vld1q_u8(reinterpret_cast<const uint8_t *>(string1 + processedLength));
+							uint8x16_t characters2 = vld1q_u8(reinterpret_cast<const uint8_t *>(string2 + processedLength));
+							characters1 = vorrq_u8(characters1, vandq_u8(MaskLetters(characters1, 'A'), kCaseBit));
+							characters2 = vorrq_u8(characters2, vandq_u8(MaskLetters(characters2, 'A'), kCaseBit));
+							if (vminvq_u8(vceqq_u8(characters1, characters2)) != 0xff)
+							{
+								break;
+							}
+							processedLength += 16;
+						}
+						return processedLength;
+					}
+
+				#else
+
+					//------------------------------------------------------------------------------
+					size_t ConvertCaseBlocks(char *buffer, size_t length, bool isToUpper)
+					{
+						return 0;
+					}
+
+					//------------------------------------------------------------------------------
+					size_t MatchNonCaseSensitiveBlocks(const char *string1, const char *string2, size_t length)
+					{
+						return 0;
+					}
+
+				#endif
+
+					//------------------------------------------------------------------------------
+					void ConvertCase(char *buffer, size_t length, bool isToUpper)
+					{
+						const char *caseValues = (isToUpper ? kToUpperTable : kToLowerTable).values;
+						for (size_t i = ConvertCaseBlocks(buffer, length, isToUpper); i < length; ++i)
+						{
+							buffer[i] = caseValues[static_cast<uint8_t>(buffer[i])];
+						}
+					}
+
+					//------------------------------------------------------------------------------
+					// Length of the common prefix, ignoring case
+					size_t MatchNonCaseSensitive(const char *string1, const char *string2, size_t length)
+					{
+						size_t matchedLength = MatchNonCaseSensitiveBlocks(string1, string2, length);
+						while (matchedLength < length && ToLowerCharacter(string1[matchedLength]) == ToLowerCharacter(string2[matchedLength]))
+						{
+							++matchedLength;
+						}
+						return matchedLength;
+					}
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// ASCIIStringUtility
+
 			//------------------------------------------------------------------------------
 			const std::string ASCIIStringUtility::kEmpty;
 			const char *ASCIIStringUtility::kWhitespaces = " \t\r\n\v\f";
@@ -120,393 +325,190 @@ namespace Leggiero
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringLTrim(const std::string &originalString, const char *trimmingCharacters)
+			std::string ASCIIStringUtility::StringLTrim(std::string_view originalString, const char *trimmingCharacters)
 			{
-				if (trimmingCharacters == nullptr)
-				{
-					for (size_t i = 0; i < originalString.size(); ++i)
-					{
-						if (originalString[i] != '\0' && !isspace(originalString[i]))
-						{
-							return std::string(originalString.begin() + i, originalString.end());
-						}
-					}
-				}
-				else
-				{
-					std::unordered_set<char> trimmingCharacterSet;
-					size_t characterCount = strlen(trimmingCharacters);
-					for (size_t i = 0; i < characterCount; ++i)
-					{
-						trimmingCharacterSet.insert(trimmingCharacters[i]);
-					}
+				return std::string(StringLTrimView(originalString, CharacterSet(trimmingCharacters)));
+			}
 
-					for (size_t i = 0; i < originalString.size(); ++i)
-					{
-						if (trimmingCharacterSet.find(originalString[i]) != trimmingCharacterSet.end())
-						{
-							return std::string(originalString.begin() + i, originalString.end());
-						}
-					}
-				}
-				return kEmpty;
+			//------------------------------------------------------------------------------
+			std::string ASCIIStringUtility::StringLTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters)
+			{
+				return std::string(StringLTrimView(originalString, CharacterSet(trimmingCharacters)));
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringLTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters)
+			std::string ASCIIStringUtility::StringRTrim(std::string_view originalString, const char *trimmingCharacters)
 			{
-				std::unordered_set<char> trimmingCharacterSet(trimmingCharacters);
-				for (size_t i = 0; i < originalString.size(); ++i)
-				{
-					if (trimmingCharacterSet.find(originalString[i]) != trimmingCharacterSet.end())
-					{
-						return std::string(originalString.begin() + i, originalString.end());
-					}
-				}
-				return kEmpty;
+				return std::string(StringRTrimView(originalString, CharacterSet(trimmingCharacters)));
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringRTrim(const std::string &originalString, const char *trimmingCharacters)
+			std::string ASCIIStringUtility::StringRTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters)
 			{
-				if (trimmingCharacters == nullptr)
-				{
-					size_t originalLength = originalString.size();
-					for (size_t i = 0; i < originalString.size(); ++i)
-					{
-						if (originalString[originalLength - i - 1] != '\0' && !isspace(originalString[originalLength - i - 1]))
-						{
-							return std::string(originalString.begin(), originalString.begin() + (originalLength - i));
-						}
-					}
-				}
-				else
-				{
-					std::unordered_set<char> trimmingCharacterSet;
-					size_t characterCount = strlen(trimmingCharacters);
-					for (size_t i = 0; i < characterCount; ++i)
-					{
-						trimmingCharacterSet.insert(trimmingCharacters[i]);
-					}
+				return std::string(StringRTrimView(originalString, CharacterSet(trimmingCharacters)));
+			}
 
-					size_t originalLength = originalString.size();
-					for (size_t i = 0; i < originalString.size(); ++i)
-					{
-						if (trimmingCharacterSet.find(originalString[originalLength - i - 1]) != trimmingCharacterSet.end())
-						{
-							return std::string(originalString.begin(), originalString.begin() + (originalLength - i));
-						}
-					}
+			//------------------------------------------------------------------------------
+			std::string ASCIIStringUtility::StringTrim(std::string_view originalString, const char *trimmingCharacters)
+			{
+				return std::string(StringTrimView(originalString, CharacterSet(trimmingCharacters)));
+			}
+
+			//------------------------------------------------------------------------------
+			std::string ASCIIStringUtility::StringTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters)
+			{
+				return std::string(StringTrimView(originalString, CharacterSet(trimmingCharacters)));
+			}
+
+			//------------------------------------------------------------------------------
+			std::string_view ASCIIStringUtility::StringLTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters)
+			{
+				size_t trimmedStart = 0;
+				while (trimmedStart < originalString.length() && trimmingCharacters.Contains(originalString[trimmedStart]))
+				{
+					++trimmedStart;
 				}
-				return kEmpty;
+				return originalString.substr(trimmedStart);
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringRTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters)
+			std::string_view ASCIIStringUtility::StringRTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters)
 			{
-				std::unordered_set<char> trimmingCharacterSet(trimmingCharacters);
-				size_t originalLength = originalString.size();
-				for (size_t i = 0; i < originalString.size(); ++i)
+				size_t trimmedLength = originalString.length();
+				while (trimmedLength > 0 && trimmingCharacters.Contains(originalString[trimmedLength - 1]))
 				{
-					if (trimmingCharacterSet.find(originalString[originalLength - i - 1]) != trimmingCharacterSet.end())
-					{
-						return std::string(originalString.begin(), originalString.begin() + (originalLength - i));
-					}
+					--trimmedLength;
 				}
-				return kEmpty;
+				return originalString.substr(0, trimmedLength);
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringTrim(const std::string &originalString, const char *trimmingCharacters)
+			std::string_view ASCIIStringUtility::StringTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters)
 			{
-				return StringLTrim(StringRTrim(originalString, trimmingCharacters), trimmingCharacters);
+				return StringLTrimView(StringRTrimView(originalString, trimmingCharacters), trimmingCharacters);
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::StringTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters)
+			void ASCIIStringUtility::StringTrimInPlace(std::string &stringToTrim, const CharacterSet &trimmingCharacters)
 			{
-				return StringLTrim(StringRTrim(originalString, trimmingCharacters), trimmingCharacters);
+				std::string_view trimmedView(StringTrimView(stringToTrim, trimmingCharacters));
+				size_t trimmedStart = static_cast<size_t>(trimmedView.data() - stringToTrim.data());
+				stringToTrim.erase(trimmedStart + trimmedView.length());
+				stringToTrim.erase(0, trimmedStart);
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::ToLower(const std::string &originalString)
+			std::string ASCIIStringUtility::ToLower(std::string_view originalString)
 			{
 				std::string workingString(originalString);
-				const size_t stringLength = workingString.length();
-
-				for (size_t i = 0; i < stringLength; ++i)
-				{
-					switch (workingString[i])
-					{
-						case 'A': workingString[i] = 'a'; break;
-						case 'B': workingString[i] = 'b'; break;
-						case 'C': workingString[i] = 'c'; break;
-						case 'D': workingString[i] = 'd'; break;
-						case 'E': workingString[i] = 'e'; break;
-						case 'F': workingString[i] = 'f'; break;
-						case 'G': workingString[i] = 'g'; break;
-						case 'H': workingString[i] = 'h'; break;
-						case 'I': workingString[i] = 'i'; break;
-						case 'J': workingString[i] = 'j'; break;
-						case 'K': workingString[i] = 'k'; break;
-						case 'L': workingString[i] = 'l'; break;
-						case 'M': workingString[i] = 'm'; break;
-						case 'N': workingString[i] = 'n'; break;
-						case 'O': workingString[i] = 'o'; break;
-						case 'P': workingString[i] = 'p'; break;
-						case 'Q': workingString[i] = 'q'; break;
-						case 'R': workingString[i] = 'r'; break;
-						case 'S': workingString[i] = 's'; break;
-						case 'T': workingString[i] = 't'; break;
-						case 'U': workingString[i] = 'u'; break;
-						case 'V': workingString[i] = 'v'; break;
-						case 'W': workingString[i] = 'w'; break;
-						case 'X': workingString[i] = 'x'; break;
-						case 'Y': workingString[i] = 'y'; break;
-						case 'Z': workingString[i] = 'z'; break;
-					}
-				}
-
+				ToLowerInPlace(workingString);
 				return workingString;
 			}
 
 			//------------------------------------------------------------------------------
-			std::string ASCIIStringUtility::ToUpper(const std::string &originalString)
+			std::string ASCIIStringUtility::ToUpper(std::string_view originalString)
 			{
 				std::string workingString(originalString);
-				const size_t stringLength = workingString.length();
-
-				for (size_t i = 0; i < stringLength; ++i)
-				{
-					switch (workingString[i])
-					{
-						case 'a': workingString[i] = 'A'; break;
-						case 'b': workingString[i] = 'B'; break;
-						case 'c': workingString[i] = 'C'; break;
-						case 'd': workingString[i] = 'D'; break;
-						case 'e': workingString[i] = 'E'; break;
-						case 'f': workingString[i] = 'F'; break;
-						case 'g': workingString[i] = 'G'; break;
-						case 'h': workingString[i] = 'H'; break;
-						case 'i': workingString[i] = 'I'; break;
-						case 'j': workingString[i] = 'J'; break;
-						case 'k': workingString[i] = 'K'; break;
-						case 'l': workingString[i] = 'L'; break;
-						case 'm': workingString[i] = 'M'; break;
-						case 'n': workingString[i] = 'N'; break;
-						case 'o': workingString[i] = 'O'; break;
-						case 'p': workingString[i] = 'P'; break;
-						case 'q': workingString[i] = 'Q'; break;
-						case 'r': workingString[i] = 'R'; break;
-						case 's': workingString[i] = 'S'; break;
-						case 't': workingString[i] = 'T'; break;
-						case 'u': workingString[i] = 'U'; break;
-						case 'v': workingString[i] = 'V'; break;
-						case 'w': workingString[i] = 'W'; break;
-						case 'x': workingString[i] = 'X'; break;
-						case 'y': workingString[i] = 'Y'; break;
-						case 'z': workingString[i] = 'Z'; break;
-					}
-				}
-
+				ToUpperInPlace(workingString);
 				return workingString;
 			}
 
 			//------------------------------------------------------------------------------
-			bool ASCIIStringUtility::IsSameStringNonCaseSensitive(const std::string &string1, const std::string &string2)
+			void ASCIIStringUtility::ToLowerInPlace(std::string &stringToConvert)
 			{
-				size_t length1 = string1.length();
-				size_t length2 = string2.length();
-				if (length1 != length2)
-				{
-					return false;
-				}
-
-				for (size_t i = 0; i < length1; ++i)
-				{
-					if (tolower(string1[i]) != tolower(string2[i]))
-					{
-						return false;
-					}
-				}
-
-				return true;
+				_Internal::ConvertCase(&stringToConvert[0], stringToConvert.length(), false);
 			}
 
 			//------------------------------------------------------------------------------
-			bool ASCIIStringUtility::IsStartWith(const std::string &stringToCheck, const std::string &startString)
+			void ASCIIStringUtility::ToLowerInPlace(char *buffer, size_t length)
 			{
-				size_t checkLength = startString.length();
-				if (checkLength == 0)
-				{
-					return true;
-				}
-				if (stringToCheck.length() < checkLength)
-				{
-					return false;
-				}
+				_Internal::ConvertCase(buffer, length, false);
+			}
 
-				for (size_t i = 0; i < checkLength; ++i)
-				{
-					if (stringToCheck[i] != startString[i])
-					{
-						return false;
-					}
-				}
+			//------------------------------------------------------------------------------
+			void ASCIIStringUtility::ToUpperInPlace(std::string &stringToConvert)
+			{
+				_Internal::ConvertCase(&stringToConvert[0], stringToConvert.length(), true);
+			}
 
-				return true;
+			//------------------------------------------------------------------------------
+			void ASCIIStringUtility::ToUpperInPlace(char *buffer, size_t length)
+			{
+				_Internal::ConvertCase(buffer, length, true);
 			}
 
 			//------------------------------------------------------------------------------
-			bool ASCIIStringUtility::IsStartWithNonCaseSensitive(const std::string &stringToCheck, const std::string &startString)
+			bool ASCIIStringUtility::IsSameStringNonCaseSensitive(std::string_view string1, std::string_view string2)
 			{
-				size_t checkLength = startString.length();
-				if (checkLength == 0)
-				{
-					return true;
-				}
-				if (stringToCheck.length() < checkLength)
+				size_t length = string1.length();
+				if (string2.length() != length)
 				{
 					return false;
 				}
-
-				for (size_t i = 0; i < checkLength; ++i)
-				{
-					if (tolower(stringToCheck[i]) != tolower(startString[i]))
-					{
-						return false;
-					}
-				}
-
-				return true;
+				return (_Internal::MatchNonCaseSensitive(string1.data(), string2.data(), length) == length);
 			}
 
 			//------------------------------------------------------------------------------
-			bool ASCIIStringUtility::IsFinishWith(const std::string &stringToCheck, const std::string &finishString)
+			int ASCIIStringUtility::CompareNonCaseSensitive(std::string_view string1, std::string_view string2)
 			{
-				size_t checkLength = finishString.length();
-				if (checkLength == 0)
+				size_t commonLength = std::min(string1.length(), string2.length());
+				size_t matchedLength = _Internal::MatchNonCaseSensitive(string1.data(), string2.data(), commonLength);
+				if (matchedLength < commonLength)
 				{
-					return true;
-				}
-				size_t stringLength = stringToCheck.length();
-				if (stringLength < checkLength)
-				{
-					return false;
+					return static_cast<int>(static_cast<uint8_t>(_Internal::ToLowerCharacter(string1[matchedLength])))
+						- static_cast<int>(static_cast<uint8_t>(_Internal::ToLowerCharacter(string2[matchedLength])));
 				}
 
-				for (size_t i = 1; i <= checkLength; ++i)
+				if (string1.length() == string2.length())
 				{
-					if (stringToCheck[stringLength - i] != finishString[checkLength - i])
-					{
-						return false;
-					}
+					return 0;
 				}
-
-				return true;
+				return ((string1.length() < string2.length()) ? -1 : 1);
 			}
 
 			//------------------------------------------------------------------------------
-			bool ASCIIStringUtility::IsFinishWithNonCaseSensitive(const std::string &stringToCheck, const std::string &finishString)
+			bool ASCIIStringUtility::IsStartWith(std::string_view stringToCheck, std::string_view startString)
 			{
-				size_t checkLength = finishString.length();
-				if (checkLength == 0)
-				{
-					return true;
-				}
-				size_t stringLength = stringToCheck.length();
-				if (stringLength < checkLength)
-				{
-					return false;
-				}
+				return (stringToCheck.length() >= startString.length() && stringToCheck.compare(0, startString.length(), startString) == 0);
+			}
 
-				for (size_t i = 1; i <= checkLength; ++i)
-				{
-					if (tolower(stringToCheck[stringLength - i]) != tolower(finishString[checkLength - i]))
-					{
-						return false;
-					}
-				}
+			//------------------------------------------------------------------------------
+			bool ASCIIStringUtility::IsStartWithNonCaseSensitive(std::string_view stringToCheck, std::string_view startString)
+			{
+				return (stringToCheck.length() >= startString.length() && IsSameStringNonCaseSensitive(stringToCheck.substr(0, startString.length()), startString));
+			}
 
-				return true;
+			//------------------------------------------------------------------------------
+			bool ASCIIStringUtility::IsFinishWith(std::string_view stringToCheck, std::string_view finishString)
+			{
+				return (stringToCheck.length() >= finishString.length() && stringToCheck.compare(stringToCheck.length() - finishString.length(), finishString.length(), finishString) == 0);
 			}
 
 			//------------------------------------------------------------------------------
-			std::vector<std::string> ASCIIStringUtility::Tokenize(const std::string &originalString, const char *delimiters, bool isIgnoreEmpty)
+			bool ASCIIStringUtility::IsFinishWithNonCaseSensitive(std::string_view stringToCheck, std::string_view finishString)
 			{
-				if (originalString.empty())
-				{
-					return std::vector<std::string>();
-				}
+				return (stringToCheck.length() >= finishString.length() && IsSameStringNonCaseSensitive(stringToCheck.substr(stringToCheck.length() - finishString.length()), finishString));
+			}
 
+			//------------------------------------------------------------------------------
+			std::vector<std::string> ASCIIStringUtility::Tokenize(std::string_view originalString, const char *delimiters, bool isIgnoreEmpty)
+			{
 				std::vector<std::string> tokenized;
-				std::vector<char> tokenBuffer; tokenBuffer.reserve(originalString.length());
-
-				std::unordered_set<char> delimeterCharacterSet;
-				size_t characterCount = strlen(delimiters);
-				for (size_t i = 0; i < characterCount; ++i)
+				for (std::string_view currentToken : TokenizeView(originalString, CharacterSet(delimiters), isIgnoreEmpty))
 				{
-					delimeterCharacterSet.insert(delimiters[i]);
+					tokenized.emplace_back(currentToken);
 				}
-
-				size_t originalStringLength = originalString.length();
-				for (size_t i = 0; i < originalStringLength; ++i)
-				{
-					if (delimeterCharacterSet.find(originalString[i]) != delimeterCharacterSet.end())
-					{
-						if (!isIgnoreEmpty || !tokenBuffer.empty())
-						{
-							tokenized.push_back(std::string(&tokenBuffer[0], tokenBuffer.size()));
-							tokenBuffer.clear();
-						}
-					}
-					else
-					{
-						tokenBuffer.push_back(originalString[i]);
-					}
-				}
-				if (!isIgnoreEmpty || !tokenBuffer.empty())
-				{
-					tokenized.push_back(std::string(&tokenBuffer[0], tokenBuffer.size()));
-				}
-
 				return tokenized;
 			}
 
 			//------------------------------------------------------------------------------
-			std::vector<std::string> ASCIIStringUtility::Tokenize(const std::string &originalString, std::initializer_list<char> delimiters, bool isIgnoreEmpty)
+			std::vector<std::string> ASCIIStringUtility::Tokenize(std::string_view originalString, std::initializer_list<char> delimiters, bool isIgnoreEmpty)
 			{
-				if (originalString.empty())
-				{
-					return std::vector<std::string>();
-				}
-
 				std::vector<std::string> tokenized;
-				std::vector<char> tokenBuffer; tokenBuffer.reserve(originalString.length());
-
-				std::unordered_set<char> delimeterCharacterSet(delimiters);
-
-				size_t originalStringLength = originalString.length();
-				for (size_t i = 0; i < originalStringLength; ++i)
-				{
-					if (delimeterCharacterSet.find(originalString[i]) != delimeterCharacterSet.end())
-					{
-						if (!isIgnoreEmpty || !tokenBuffer.empty())
-						{
-							tokenized.push_back(std::string(&tokenBuffer[0], tokenBuffer.size()));
-							tokenBuffer.clear();
-						}
-					}
-					else
-					{
-						tokenBuffer.push_back(originalString[i]);
-					}
-				}
-				if (!isIgnoreEmpty || !tokenBuffer.empty())
+				for (std::string_view currentToken : TokenizeView(originalString, CharacterSet(delimiters), isIgnoreEmpty))
 				{
-					tokenized.push_back(std::string(&tokenBuffer[0], tokenBuffer.size()));
+					tokenized.emplace_back(currentToken);
 				}
-
 				return tokenized;
 			}
 
@@ -705,6 +707,98 @@ namespace Leggiero
 
 				return std::string(&buffer[0], bufferSize);;
 			}
+
+			//------------------------------------------------------------------------------
+			ASCIIStringUtility::TokenRange ASCIIStringUtility::TokenizeView(std::string_view originalString, const CharacterSet &delimiters, bool isIgnoreEmpty)
+			{
+				return TokenRange(originalString, delimiters, isIgnoreEmpty);
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// ASCIIStringUtility::CharacterSet
+
+			//------------------------------------------------------------------------------
+			ASCIIStringUtility::CharacterSet::CharacterSet(const char *characters)
+				: m_bits{ 0, 0, 0, 0 }
+			{
+				if (characters == nullptr)
+				{
+					characters = kWhitespaces;
+					m_bits[0] |= 1;	// NULL character
+				}
+				for (const char *currentCharacter = characters; *currentCharacter != '\0'; ++currentCharacter)
+				{
+					uint8_t code = static_cast<uint8_t>(*currentCharacter);
+					m_bits[code >> 6] |= (static_cast<uint64_t>(1) << (code & 0x3f));
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			ASCIIStringUtility::CharacterSet::CharacterSet(std::initializer_list<char> characters)
+				: m_bits{ 0, 0, 0, 0 }
+			{
+				for (char currentCharacter : characters)
+				{
+					uint8_t code = static_cast<uint8_t>(currentCharacter);
+					m_bits[code >> 6] |= (static_cast<uint64_t>(1) << (code & 0x3f));
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// ASCIIStringUtility::TokenRange
+
+			//------------------------------------------------------------------------------
+			ASCIIStringUtility::TokenRange::Iterator::Iterator(const TokenRange *range, size_t searchStart)
+				: m_range(range), m_tokenStart(std::string_view::npos)
+			{
+				_FindFrom(searchStart);
+			}
+
+			//------------------------------------------------------------------------------
+			// Find the token starting at searchStart, or the next non-empty one when ignoring empty tokens
+			void ASCIIStringUtility::TokenRange::Iterator::_FindFrom(size_t searchStart)
+			{
+				const std::string_view &originalString = m_range->m_originalString;
+				const size_t originalLength = originalString.length();
+
+				while (true)
+				{
+					size_t tokenEnd = searchStart;
+					while (tokenEnd < originalLength && !m_range->m_delimiters.Contains(originalString[tokenEnd]))
+					{
+						++tokenEnd;
+					}
+
+					if (!m_range->m_isIgnoreEmpty || tokenEnd > searchStart)
+					{
+						m_tokenStart = searchStart;
+						m_token = originalString.substr(searchStart, tokenEnd - searchStart);
+						return;
+					}
+					if (tokenEnd >= originalLength)
+					{
+						break;
+					}
+					searchStart = tokenEnd + 1;
+				}
+
+				m_tokenStart = std::string_view::npos;
+				m_token = std::string_view();
+			}
+
+			//------------------------------------------------------------------------------
+			void ASCIIStringUtility::TokenRange::Iterator::_MoveNext()
+			{
+				size_t tokenEnd = m_tokenStart + m_token.length();
+				if (tokenEnd >= m_range->m_originalString.length())
+				{
+					// Last token
+					m_tokenStart = std::string_view::npos;
+					m_token = std::string_view();
+					return;
+				}
+				_FindFrom(tokenEnd + 1);
+			}
 		}
 	}
 }
@@ -18,8 +18,12 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standrad Library
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -36,6 +40,80 @@ namespace Leggiero
 				using ProcessingString = std::string;
 				using ProcessingChar = char;
 
+				// Bit table of characters for trimming and tokenizing
+				// nullptr means whitespaces including the NULL character.
+				class CharacterSet
+				{
+				public:
+					CharacterSet(const char *characters = nullptr);
+					CharacterSet(std::initializer_list<char> characters);
+
+				public:
+					bool Contains(char character) const
+					{
+						uint8_t code = static_cast<uint8_t>(character);
+						return ((m_bits[code >> 6] >> (code & 0x3f)) & 1) != 0;
+					}
+
+				protected:
+					uint64_t m_bits[4];
+				};
+
+				// Forward range of tokens, as views into the original string
+				// The original string should outlive the range and its iterators, and the range should outlive its iterators.
+				class TokenRange
+				{
+				public:
+					class Iterator
+					{
+					public:
+						using iterator_category = std::forward_iterator_tag;
+						using value_type = std::string_view;
+						using difference_type = std::ptrdiff_t;
+						using pointer = const std::string_view *;
+						using reference = const std::string_view &;
+
+					public:
+						Iterator() : m_range(nullptr), m_tokenStart(std::string_view::npos) { }
+
+					public:
+						reference operator*() const { return m_token; }
+						pointer operator->() const { return &m_token; }
+
+						Iterator &operator++() { _MoveNext(); return *this; }
+						Iterator operator++(int) { Iterator previous(*this); _MoveNext(); return previous; }
+
+						bool operator==(const Iterator &other) const { return (m_range == other.m_range && m_tokenStart == other.m_tokenStart); }
+						bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+					protected:
+						friend class TokenRange;
+						Iterator(const TokenRange *range, size_t searchStart);
+
+						void _FindFrom(size_t searchStart);
+						void _MoveNext();
+
+					protected:
+						const TokenRange	*m_range;
+						size_t				m_tokenStart;
+						std::string_view	m_token;
+					};
+
+				public:
+					TokenRange(std::string_view originalString, const CharacterSet &delimiters, bool isIgnoreEmpty)
+						: m_originalString(originalString), m_delimiters(delimiters), m_isIgnoreEmpty(isIgnoreEmpty)
+					{ }
+
+				public:
+					Iterator begin() const { return (m_originalString.empty() ? end() : Iterator(this, 0)); }
+					Iterator end() const { Iterator endIterator; endIterator.m_range = this; return endIterator; }
+
+				protected:
+					std::string_view	m_originalString;
+					CharacterSet		m_delimiters;
+					bool				m_isIgnoreEmpty;
+				};
+
 			public:	// Constants
 				static constexpr char kNULL = '\0';
 				static const std::string kEmpty;
@@ -49,31 +127,49 @@ namespace Leggiero
 				static std::string FilterString(const std::string &originalString, std::initializer_list<char> filteringCharacters, const char *replaceChar = nullptr);
 
 			public:	// Trimming
-				static std::string StringLTrim(const std::string &originalString, const char *trimmingCharacters = nullptr);
-				static std::string StringLTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters);
-				static std::string StringRTrim(const std::string &originalString, const char *trimmingCharacters = nullptr);
-				static std::string StringRTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters);
-				static std::string StringTrim(const std::string &originalString, const char *trimmingCharacters = nullptr);
-				static std::string StringTrim(const std::string &originalString, std::initializer_list<char> trimmingCharacters);
+				static std::string StringLTrim(std::string_view originalString, const char *trimmingCharacters = nullptr);
+				static std::string StringLTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters);
+				static std::string StringRTrim(std::string_view originalString, const char *trimmingCharacters = nullptr);
+				static std::string StringRTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters);
+				static std::string StringTrim(std::string_view originalString, const char *trimmingCharacters = nullptr);
+				static std::string StringTrim(std::string_view originalString, std::initializer_list<char> trimmingCharacters);
+
+				// Without allocation; results are views into the original string
+				static std::string_view StringLTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters = CharacterSet());
+				static std::string_view StringRTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters = CharacterSet());
+				static std::string_view StringTrimView(std::string_view originalString, const CharacterSet &trimmingCharacters = CharacterSet());
+
+				static void StringTrimInPlace(std::string &stringToTrim, const CharacterSet &trimmingCharacters = CharacterSet());
 
 			public:	// Case
-				static std::string ToLower(const std::string &originalString);
-				static std::string ToUpper(const std::string &originalString);
+				static std::string ToLower(std::string_view originalString);
+				static std::string ToUpper(std::string_view originalString);
+
+				static void ToLowerInPlace(std::string &stringToConvert);
+				static void ToLowerInPlace(char *buffer, size_t length);
+				static void ToUpperInPlace(std::string &stringToConvert);
+				static void ToUpperInPlace(char *buffer, size_t length);
 
 			public:	// Compare
-				static bool IsSameStringNonCaseSensitive(const std::string &string1, const std::string &string2);
+				static bool IsSameStringNonCaseSensitive(std::string_view string1, std::string_view string2);
+
+				// Negative, zero, or positive as strcasecmp
+				static int CompareNonCaseSensitive(std::string_view string1, std::string_view string2);
 
-				static bool IsStartWith(const std::string &stringToCheck, const std::string &startString);
-				static bool IsStartWithNonCaseSensitive(const std::string &stringToCheck, const std::string &startString);
+				static bool IsStartWith(std::string_view stringToCheck, std::string_view startString);
+				static bool IsStartWithNonCaseSensitive(std::string_view stringToCheck, std::string_view startString);
 
-				static bool IsFinishWith(const std::string &stringToCheck, const std::string &finishString);
-				static bool IsFinishWithNonCaseSensitive(const std::string &stringToCheck, const std::string &finishString);
+				static bool IsFinishWith(std::string_view stringToCheck, std::string_view finishString);
+				static bool IsFinishWithNonCaseSensitive(std::string_view stringToCheck, std::string_view finishString);
 
 			public:	// Tokenize
-				static std::vector<std::string> Tokenize(const std::string &originalString, const char *delimiters = nullptr, bool isIgnoreEmpty = false);
-				static std::vector<std::string> Tokenize(const std::string &originalString, std::initializer_list<char> delimiters, bool isIgnoreEmpty = false);
+				static std::vector<std::string> Tokenize(std::string_view originalString, const char *delimiters = nullptr, bool isIgnoreEmpty = false);
+				static std::vector<std::string> Tokenize(std::string_view originalString, std::initializer_list<char> delimiters, bool isIgnoreEmpty = false);
 				static std::vector<std::string> TokenizeByString(const std::string &originalString, const std::string &delimiterString, bool isIgnoreEmpty = false);
 
+				// Without allocation; e.g. for (std::string_view token : TokenizeView(line, { ',' })) { ... }
+				static TokenRange TokenizeView(std::string_view originalString, const CharacterSet &delimiters = CharacterSet(), bool isIgnoreEmpty = false);
+
 			public:	// Join
 				static std::string Join(const std::vector<std::string> &stringsToJoin, const std::string &separator = kEmpty, bool isTrailingSeparator = false, bool isAheadingSeparator = false);
 				static std::string JoinWithBuffer(const std::vector<std::string> &stringsToJoin, std::vector<char> &buffer, const std::string &separator = kEmpty, bool isTrailingSeparator = false, bool isAheadingSeparator = false);
@@ -11,14 +11,13 @@
 // Standard Library
 #include <cstdlib>
 #include <algorithm>
-#include <list>
-
-// External Library
-#include <errno.h>
-#include <pthread.h>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
 
 // Leggiero.Utility
-#include "Finally.h"
+#include "../Threading/ManagedThreadPrimitives.h"
 
 
 namespace Leggiero
@@ -27,86 +26,221 @@ namespace Leggiero
 	{
 		namespace DesignPattern
 		{
+			namespace _Internal
+			{
+				// Notifications running on current thread, so that an observer can (un)register during a notification
+				struct EventNotifyingFrame
+				{
+				public:
+					const void				*notifier;
+					int						readerSlot;
+					EventNotifyingFrame		*outerFrame;
+				};
+
+				inline thread_local EventNotifyingFrame *t_eventNotifyingFrame = nullptr;
+			}
+
+
 			// Event Notifier
+			// Observers are kept in an immutable snapshot replaced on every change (copy-on-write),
+			// so a notification only loads the snapshot and loops on it, without any lock.
+			// Registering and unregistering are slow: they copy the list and wait for running notifications on other threads.
+			// After UnRegisterObserver returns, the observer is not called by any notification of other threads.
+			// An observer may register or unregister during a notification; the change applies from the next notification.
 			template <typename ObserverT>
 			class EventNotifier
 			{
+			protected:
+				using ObserverList = std::vector<ObserverT>;
+
 			public:
 				EventNotifier()
+					: m_snapshot(new ObserverList()), m_readerSlot(0)
 				{
-					pthread_rwlock_init(&m_observerListLock, NULL);
+					m_readerCounts[0].store(0);
+					m_readerCounts[1].store(0);
 				}
 
 				virtual ~EventNotifier()
 				{
-					pthread_rwlock_destroy(&m_observerListLock);
+					delete m_snapshot.load();
+					for (const ObserverList *retiredSnapshot : m_retiredSnapshots)
+					{
+						delete retiredSnapshot;
+					}
 				}
 
+				EventNotifier(const EventNotifier &other) = delete;
+				EventNotifier &operator=(const EventNotifier &other) = delete;
+
 			public:
 				// Notify event for all observers: call notify function for all observers
 				template<class UnaryFunction>
 				void NotifyEvent(UnaryFunction notifyFunc)
 				{
-					int readLockResult;
-					while ((readLockResult = pthread_rwlock_rdlock(&m_observerListLock)) == EAGAIN)
-					{
-						sched_yield();
-					}
-					if (readLockResult == 0)
-					{
-						pthread_rwlock_t *listLock = &m_observerListLock;
-						auto releaseLockFunc = [listLock]() mutable { pthread_rwlock_unlock(listLock); };
-						FINALLY_OF_BLOCK(_RELEASE_READ_LOCK, releaseLockFunc);
-
-						std::for_each(m_observers.begin(), m_observers.end(), notifyFunc);
-					}
+					_ReadingScope readingScope(this);
+					std::for_each(readingScope.Snapshot()->begin(), readingScope.Snapshot()->end(), notifyFunc);
 				}
 
 				// Register an Observer
 				void RegisterObserver(ObserverT observer)
 				{
-					int writeLockResult = pthread_rwlock_wrlock(&m_observerListLock);
-					if (writeLockResult == 0)
+					Utility::Threading::ScopedMutexLock writerLockContext(m_writerLock);
+					if (writerLockContext)
 					{
-						pthread_rwlock_t *listLock = &m_observerListLock;
-						auto releaseLockFunc = [listLock]() mutable { pthread_rwlock_unlock(listLock); };
-						FINALLY_OF_BLOCK(_RELEASE_WRITE_LOCK, releaseLockFunc);
-
-						m_observers.push_back(observer);
+						ObserverList *newSnapshot = new ObserverList(*m_snapshot.load());
+						newSnapshot->push_back(observer);
+						_PublishSnapshot(newSnapshot);
 					}
 				}
 
 				// Remove an Observer
 				void UnRegisterObserver(ObserverT observer)
 				{
-					int writeLockResult = pthread_rwlock_wrlock(&m_observerListLock);
-					if (writeLockResult == 0)
+					Utility::Threading::ScopedMutexLock writerLockContext(m_writerLock);
+					if (writerLockContext)
 					{
-						pthread_rwlock_t *listLock = &m_observerListLock;
-						auto releaseLockFunc = [listLock]() mutable { pthread_rwlock_unlock(listLock); };
-						FINALLY_OF_BLOCK(_RELEASE_WRITE_LOCK, releaseLockFunc);
-
-						m_observers.remove(observer);
+						const ObserverList *currentSnapshot = m_snapshot.load();
+						if (std::find(currentSnapshot->begin(), currentSnapshot->end(), observer) == currentSnapshot->end())
+						{
+							return;
+						}
+
+						ObserverList *newSnapshot = new ObserverList();
+						newSnapshot->reserve(currentSnapshot->size());
+						std::remove_copy(currentSnapshot->begin(), currentSnapshot->end(), std::back_inserter(*newSnapshot), observer);
+						_PublishSnapshot(newSnapshot);
 					}
 				}
 
 				// Clear ALL Observers
 				void ClearObserver()
 				{
-					int writeLockResult = pthread_rwlock_wrlock(&m_observerListLock);
-					if (writeLockResult == 0)
+					Utility::Threading::ScopedMutexLock writerLockContext(m_writerLock);
+					if (writerLockContext)
+					{
+						_PublishSnapshot(new ObserverList());
+					}
+				}
+
+			protected:
+				// Reader side of a notification
+				//note: a reader is counted in the slot current at its start; re-checking the slot after counting makes
+				//      every counted reader visible to a writer that flips the slot afterwards
+				class _ReadingScope
+				{
+				public:
+					_ReadingScope(EventNotifier *notifier)
+						: m_notifier(notifier)
+					{
+						int readerSlot = notifier->m_readerSlot.load();
+						while (true)
+						{
+							notifier->m_readerCounts[readerSlot].fetch_add(1);
+							int currentSlot = notifier->m_readerSlot.load();
+							if (currentSlot == readerSlot)
+							{
+								break;
+							}
+
+							// Racing with a writer; count in the new slot
+							notifier->m_readerCounts[readerSlot].fetch_sub(1);
+							readerSlot = currentSlot;
+						}
+
+						m_snapshot = notifier->m_snapshot.load();
+
+						m_frame.notifier = notifier;
+						m_frame.readerSlot = readerSlot;
+						m_frame.outerFrame = _Internal::t_eventNotifyingFrame;
+						_Internal::t_eventNotifyingFrame = &m_frame;
+					}
+
+					~_ReadingScope()
+					{
+						_Internal::t_eventNotifyingFrame = m_frame.outerFrame;
+						m_notifier->m_readerCounts[m_frame.readerSlot].fetch_sub(1);
+					}
+
+					_ReadingScope(const _ReadingScope &other) = delete;
+					_ReadingScope &operator=(const _ReadingScope &other) = delete;
+
+				public:
+					const ObserverList *Snapshot() const { return m_snapshot; }
+
+				protected:
+					EventNotifier						*m_notifier;
+					const ObserverList					*m_snapshot;
+					_Internal::EventNotifyingFrame		m_frame;
+				};
+
+			protected:
+				// Replace the snapshot, and free the old one after notifications using it finished
+				// Should be called in the writer lock
+				void _PublishSnapshot(ObserverList *newSnapshot)
+				{
+					const ObserverList *oldSnapshot = m_snapshot.exchange(newSnapshot);
+
+					bool isNotifyingOnThisThread = _WaitGracePeriod();
+					if (isNotifyingOnThisThread)
+					{
+						// Still iterated by an outer notification of this thread
+						m_retiredSnapshots.push_back(oldSnapshot);
+						return;
+					}
+
+					delete oldSnapshot;
+
+					if (!m_retiredSnapshots.empty())
+					{
+						// Retired ones can be held by readers counted in either slot
+						_WaitGracePeriod();
+						for (const ObserverList *retiredSnapshot : m_retiredSnapshots)
+						{
+							delete retiredSnapshot;
+						}
+						m_retiredSnapshots.clear();
+					}
+				}
+
+				// Flip the reader slot and wait for readers counted in the old slot
+				// Returns whether this thread is in a notification of this notifier; such readers are not waited.
+				bool _WaitGracePeriod()
+				{
+					int oldSlot = m_readerSlot.load();
+					m_readerSlot.store(1 - oldSlot);
+
+					int ownReaderCount = 0;
+					bool isNotifyingOnThisThread = false;
+					for (_Internal::EventNotifyingFrame *currentFrame = _Internal::t_eventNotifyingFrame; currentFrame != nullptr; currentFrame = currentFrame->outerFrame)
 					{
-						pthread_rwlock_t *listLock = &m_observerListLock;
-						auto releaseLockFunc = [listLock]() mutable { pthread_rwlock_unlock(listLock); };
-						FINALLY_OF_BLOCK(_RELEASE_WRITE_LOCK, releaseLockFunc);
+						if (currentFrame->notifier == this)
+						{
+							isNotifyingOnThisThread = true;
+							if (currentFrame->readerSlot == oldSlot)
+							{
+								++ownReaderCount;
+							}
+						}
+					}
 
-						m_observers.clear();
+					while (m_readerCounts[oldSlot].load() > ownReaderCount)
+					{
+						std::this_thread::yield();
 					}
+
+					return isNotifyingOnThisThread;
 				}
 
 			private:
-				std::list<ObserverT>	m_observers;
-				pthread_rwlock_t		m_observerListLock;
+				std::atomic<const ObserverList *>	m_snapshot;
+
+				// Running notifications, counted by two slots flipped by writers
+				std::atomic_int						m_readerSlot;
+				std::atomic_int						m_readerCounts[2];
+
+				Utility::Threading::SafePthreadLock	m_writerLock;
+				std::vector<const ObserverList *>	m_retiredSnapshots;
 			};
 		}
 	}
@@ -7,6 +7,14 @@
 // My Header
 #include "ManagedThreadPrimitives.h"
 
+// Standard Library
+#include <thread>
+
+// External Library
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+	#include <immintrin.h>
+#endif
+
 
 namespace Leggiero
 {
@@ -150,6 +158,86 @@ namespace Leggiero
 			{
 				pthread_cond_destroy(&m_conditionVariable);
 			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// AdaptiveSpinMutex
+
+			namespace _Internal
+			{
+				//------------------------------------------------------------------------------
+				// Hint the CPU that we are in a spin loop
+				inline void CPURelax()
+				{
+					#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+						_mm_pause();
+					#elif defined(__aarch64__) || defined(__arm__)
+						__asm__ __volatile__("yield");
+					#else
+						std::this_thread::yield();
+					#endif
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			AdaptiveSpinMutex::AdaptiveSpinMutex()
+				: m_state(kUnlocked), m_averageSpinCount(kMinSpinCount)
+			{
+				pthread_mutex_init(&m_parkMutex, NULL);
+				pthread_cond_init(&m_parkCondition, NULL);
+			}
+
+			//------------------------------------------------------------------------------
+			AdaptiveSpinMutex::~AdaptiveSpinMutex()
+			{
+				pthread_cond_destroy(&m_parkCondition);
+				pthread_mutex_destroy(&m_parkMutex);
+			}
+
+			//------------------------------------------------------------------------------
+			void AdaptiveSpinMutex::_LockSlow()
+			{
+				// Spin up to twice of usual wait, to follow changes of the holding time
+				int averageSpinCount = m_averageSpinCount.load(std::memory_order_relaxed);
+				int spinLimit = averageSpinCount * 2 + kMinSpinCount;
+				if (spinLimit > kMaxSpinCount)
+				{
+					spinLimit = kMaxSpinCount;
+				}
+
+				for (int spinCount = 0; spinCount < spinLimit; ++spinCount)
+				{
+					if (m_state.load(std::memory_order_relaxed) == kUnlocked)
+					{
+						int expectedState = kUnlocked;
+						if (m_state.compare_exchange_weak(expectedState, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+						{
+							m_averageSpinCount.store(averageSpinCount + (spinCount - averageSpinCount) / 8, std::memory_order_relaxed);
+							return;
+						}
+					}
+					_Internal::CPURelax();
+				}
+
+				// Spinning did not pay; spin less next time
+				m_averageSpinCount.store(averageSpinCount + (kMinSpinCount - averageSpinCount) / 8, std::memory_order_relaxed);
+
+				// Park until the holder releases
+				//note: state is marked as having waiters while holding the park mutex, so an unlocker signals only after we wait
+				pthread_mutex_lock(&m_parkMutex);
+				while (m_state.exchange(kLockedWithWaiters, std::memory_order_acquire) != kUnlocked)
+				{
+					pthread_cond_wait(&m_parkCondition, &m_parkMutex);
+				}
+				pthread_mutex_unlock(&m_parkMutex);
+			}
+
+			//------------------------------------------------------------------------------
+			void AdaptiveSpinMutex::_WakeWaiter()
+			{
+				pthread_mutex_lock(&m_parkMutex);
+				pthread_cond_signal(&m_parkCondition);
+				pthread_mutex_unlock(&m_parkMutex);
+			}
 		}
 	}
 }
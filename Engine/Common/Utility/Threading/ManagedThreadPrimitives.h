@@ -9,6 +9,7 @@
 
 
 // Standard Library
+#include <atomic>
 #include <memory>
 
 // External Library
@@ -54,6 +55,7 @@ namespace Leggiero
 				};
 
 				// Lock and return auto-unlocking handle
+				// The handle is heap allocated; use ScopedMutexLock in frequently called code.
 				std::unique_ptr<LockContext> Lock();
 
 			public:
@@ -93,6 +95,250 @@ namespace Leggiero
 			public:
 				pthread_cond_t m_conditionVariable;
 			};
+
+
+			//////////////////////////////////////////////////////////////////////////////// Scoped Lock Guards
+
+			// Stack-only guards, unlocking at the end of the scope without any allocation
+			// A guard evaluates to false if locking failed, like the handle of SafePthreadLock::Lock().
+
+			// Locks a mutex for the scope
+			class ScopedMutexLock
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				explicit ScopedMutexLock(pthread_mutex_t &mutex)
+					: m_mutex(&mutex)
+				{
+					if (pthread_mutex_lock(m_mutex) != 0)
+					{
+						m_mutex = nullptr;
+					}
+				}
+
+				explicit ScopedMutexLock(SafePthreadLock &lock)
+					: ScopedMutexLock(lock.GetLock())
+				{ }
+
+				~ScopedMutexLock() { UnlockNow(); }
+
+			public:
+				bool IsLocked() const { return (m_mutex != nullptr); }
+				explicit operator bool() const { return IsLocked(); }
+
+				void UnlockNow()
+				{
+					if (m_mutex != nullptr)
+					{
+						pthread_mutex_unlock(m_mutex);
+						m_mutex = nullptr;
+					}
+				}
+
+			protected:
+				pthread_mutex_t *m_mutex;
+			};
+
+
+			// Tries to lock a mutex without blocking; check IsLocked() before entering the critical section
+			class ScopedMutexTryLock
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				explicit ScopedMutexTryLock(pthread_mutex_t &mutex)
+					: m_mutex(&mutex)
+				{
+					if (pthread_mutex_trylock(m_mutex) != 0)
+					{
+						m_mutex = nullptr;
+					}
+				}
+
+				explicit ScopedMutexTryLock(SafePthreadLock &lock)
+					: ScopedMutexTryLock(lock.GetLock())
+				{ }
+
+				~ScopedMutexTryLock() { UnlockNow(); }
+
+			public:
+				bool IsLocked() const { return (m_mutex != nullptr); }
+				explicit operator bool() const { return IsLocked(); }
+
+				void UnlockNow()
+				{
+					if (m_mutex != nullptr)
+					{
+						pthread_mutex_unlock(m_mutex);
+						m_mutex = nullptr;
+					}
+				}
+
+			protected:
+				pthread_mutex_t *m_mutex;
+			};
+
+
+			// Holds shared read access of a RW lock for the scope
+			class ScopedReadLock
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				explicit ScopedReadLock(pthread_rwlock_t &rwLock)
+					: m_rwLock(&rwLock)
+				{
+					if (pthread_rwlock_rdlock(m_rwLock) != 0)
+					{
+						m_rwLock = nullptr;
+					}
+				}
+
+				explicit ScopedReadLock(SafePthreadRWLock &lock)
+					: ScopedReadLock(lock.GetLock())
+				{ }
+
+				~ScopedReadLock() { UnlockNow(); }
+
+			public:
+				bool IsLocked() const { return (m_rwLock != nullptr); }
+				explicit operator bool() const { return IsLocked(); }
+
+				void UnlockNow()
+				{
+					if (m_rwLock != nullptr)
+					{
+						pthread_rwlock_unlock(m_rwLock);
+						m_rwLock = nullptr;
+					}
+				}
+
+			protected:
+				pthread_rwlock_t *m_rwLock;
+			};
+
+
+			// Holds exclusive write access of a RW lock for the scope
+			class ScopedWriteLock
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				explicit ScopedWriteLock(pthread_rwlock_t &rwLock)
+					: m_rwLock(&rwLock)
+				{
+					if (pthread_rwlock_wrlock(m_rwLock) != 0)
+					{
+						m_rwLock = nullptr;
+					}
+				}
+
+				explicit ScopedWriteLock(SafePthreadRWLock &lock)
+					: ScopedWriteLock(lock.GetLock())
+				{ }
+
+				~ScopedWriteLock() { UnlockNow(); }
+
+			public:
+				bool IsLocked() const { return (m_rwLock != nullptr); }
+				explicit operator bool() const { return IsLocked(); }
+
+				void UnlockNow()
+				{
+					if (m_rwLock != nullptr)
+					{
+						pthread_rwlock_unlock(m_rwLock);
+						m_rwLock = nullptr;
+					}
+				}
+
+			protected:
+				pthread_rwlock_t *m_rwLock;
+			};
+
+
+			//////////////////////////////////////////////////////////////////////////////// AdaptiveSpinMutex
+
+			// Mutex for short critical sections: spins a while before parking the thread
+			// Spin limit adapts to how long the lock was actually waited, like adaptive pthread mutexes.
+			// Not recursive. Parking uses pthread primitives, so a long wait costs no CPU.
+			class AdaptiveSpinMutex
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				AdaptiveSpinMutex();
+				~AdaptiveSpinMutex();
+
+			public:
+				void Lock()
+				{
+					int expectedState = kUnlocked;
+					if (m_state.compare_exchange_strong(expectedState, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+					{
+						return;
+					}
+					_LockSlow();
+				}
+
+				bool TryLock()
+				{
+					int expectedState = kUnlocked;
+					return m_state.compare_exchange_strong(expectedState, kLocked, std::memory_order_acquire, std::memory_order_relaxed);
+				}
+
+				void Unlock()
+				{
+					if (m_state.exchange(kUnlocked, std::memory_order_release) == kLockedWithWaiters)
+					{
+						_WakeWaiter();
+					}
+				}
+
+			protected:
+				static constexpr int kUnlocked = 0;
+				static constexpr int kLocked = 1;
+				static constexpr int kLockedWithWaiters = 2;
+
+				static constexpr int kMaxSpinCount = 1000;
+				static constexpr int kMinSpinCount = 16;
+
+				void _LockSlow();
+				void _WakeWaiter();
+
+			protected:
+				std::atomic_int m_state;
+
+				// Moving average of spins needed to acquire; only a hint, so relaxed
+				std::atomic_int m_averageSpinCount;
+
+				pthread_mutex_t m_parkMutex;
+				pthread_cond_t m_parkCondition;
+			};
+
+
+			// Locks an AdaptiveSpinMutex for the scope
+			class ScopedSpinMutexLock
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				explicit ScopedSpinMutexLock(AdaptiveSpinMutex &mutex)
+					: m_mutex(&mutex)
+				{
+					m_mutex->Lock();
+				}
+
+				~ScopedSpinMutexLock() { UnlockNow(); }
+
+			public:
+				void UnlockNow()
+				{
+					if (m_mutex != nullptr)
+					{
+						m_mutex->Unlock();
+						m_mutex = nullptr;
+					}
+				}
+
+			protected:
+				AdaptiveSpinMutex *m_mutex;
+			};
 		}
 	}
 }
@@ -0,0 +1,395 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/RingBuffer.h (Leggiero - Utility)
+//
+// Fixed-capacity lock-free ring buffers for passing items between threads
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __UTILITY__THREADING__RING_BUFFER_H
+#define __UTILITY__THREADING__RING_BUFFER_H
+
+
+// Standard Library
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Leggiero.Utility
+#include "../Sugar/NonCopyable.h"
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			namespace _Internal
+			{
+				// Indices written by different threads are kept in separate cache lines, not to be falsely shared
+				constexpr size_t kRingBufferCacheLineSize = 64;
+
+				//------------------------------------------------------------------------------
+				inline size_t RoundUpRingBufferCapacity(size_t capacity)
+				{
+					size_t roundedCapacity = 2;
+					while (roundedCapacity < capacity)
+					{
+						roundedCapacity <<= 1;
+					}
+					return roundedCapacity;
+				}
+			}
+
+
+			// Single-Producer Single-Consumer Ring Buffer
+			// Push from one thread and pop from one other thread; every operation is wait-free, so can be used in real-time threads.
+			// Capacity is rounded up to a power of two, and memory is allocated only in the constructor.
+			template <typename T>
+			class SPSCRingBuffer
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				using ValueType = T;
+
+			public:
+				explicit SPSCRingBuffer(size_t capacity)
+					: m_capacity(_Internal::RoundUpRingBufferCapacity(capacity)), m_indexMask(m_capacity - 1)
+					, m_slots(new SlotType[m_capacity])
+					, m_producerIndex(0), m_cachedConsumerIndex(0)
+					, m_consumerIndex(0), m_cachedProducerIndex(0)
+				{ }
+
+				~SPSCRingBuffer()
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_relaxed);
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					for (size_t i = consumerIndex; i != producerIndex; ++i)
+					{
+						_Item(i)->~T();
+					}
+				}
+
+			public:	// Producer Side
+				template <typename... ArgTs>
+				bool TryEmplace(ArgTs &&... args)
+				{
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					if (producerIndex - m_cachedConsumerIndex >= m_capacity)
+					{
+						m_cachedConsumerIndex = m_consumerIndex.load(std::memory_order_acquire);
+						if (producerIndex - m_cachedConsumerIndex >= m_capacity)
+						{
+							// Full
+							return false;
+						}
+					}
+
+					new (_Item(producerIndex)) T(std::forward<ArgTs>(args)...);
+					m_producerIndex.store(producerIndex + 1, std::memory_order_release);
+					return true;
+				}
+
+				bool TryPush(const T &item) { return TryEmplace(item); }
+				bool TryPush(T &&item) { return TryEmplace(std::move(item)); }
+
+				// Push items as many as free space, and returns the count of pushed items
+				size_t PushBulk(const T *items, size_t itemCount)
+				{
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					size_t freeCount = m_capacity - (producerIndex - m_cachedConsumerIndex);
+					if (freeCount < itemCount)
+					{
+						m_cachedConsumerIndex = m_consumerIndex.load(std::memory_order_acquire);
+						freeCount = m_capacity - (producerIndex - m_cachedConsumerIndex);
+					}
+
+					size_t pushCount = ((itemCount < freeCount) ? itemCount : freeCount);
+					for (size_t i = 0; i < pushCount; ++i)
+					{
+						new (_Item(producerIndex + i)) T(items[i]);
+					}
+
+					// Publish all at once
+					m_producerIndex.store(producerIndex + pushCount, std::memory_order_release);
+					return pushCount;
+				}
+
+			public:	// Consumer Side
+				bool TryPop(T &outItem)
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_relaxed);
+					if (consumerIndex == m_cachedProducerIndex)
+					{
+						m_cachedProducerIndex = m_producerIndex.load(std::memory_order_acquire);
+						if (consumerIndex == m_cachedProducerIndex)
+						{
+							// Empty
+							return false;
+						}
+					}
+
+					T *item = _Item(consumerIndex);
+					outItem = std::move(*item);
+					item->~T();
+					m_consumerIndex.store(consumerIndex + 1, std::memory_order_release);
+					return true;
+				}
+
+				// Pop items up to maxCount, and returns the count of popped items
+				size_t PopBulk(T *outItems, size_t maxCount)
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_relaxed);
+					size_t readyCount = m_cachedProducerIndex - consumerIndex;
+					if (readyCount < maxCount)
+					{
+						m_cachedProducerIndex = m_producerIndex.load(std::memory_order_acquire);
+						readyCount = m_cachedProducerIndex - consumerIndex;
+					}
+
+					size_t popCount = ((maxCount < readyCount) ? maxCount : readyCount);
+					for (size_t i = 0; i < popCount; ++i)
+					{
+						T *item = _Item(consumerIndex + i);
+						outItems[i] = std::move(*item);
+						item->~T();
+					}
+
+					// Release all at once
+					m_consumerIndex.store(consumerIndex + popCount, std::memory_order_release);
+					return popCount;
+				}
+
+			public:
+				size_t GetCapacity() const { return m_capacity; }
+
+				// Can be called from any thread, but changes by other threads make it approximate
+				size_t GetSizeApprox() const
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_acquire);
+					size_t producerIndex = m_producerIndex.load(std::memory_order_acquire);
+					return ((producerIndex > consumerIndex) ? (producerIndex - consumerIndex) : 0);
+				}
+
+				bool IsEmptyApprox() const { return (GetSizeApprox() == 0); }
+
+			protected:
+				using SlotType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+				T *_Item(size_t index) { return reinterpret_cast<T *>(&m_slots[index & m_indexMask]); }
+
+			protected:
+				const size_t					m_capacity;
+				const size_t					m_indexMask;
+				std::unique_ptr<SlotType[]>		m_slots;
+
+				// Producer owned
+				alignas(_Internal::kRingBufferCacheLineSize) std::atomic<size_t>	m_producerIndex;
+				size_t																m_cachedConsumerIndex;
+
+				// Consumer owned
+				alignas(_Internal::kRingBufferCacheLineSize) std::atomic<size_t>	m_consumerIndex;
+				size_t																m_cachedProducerIndex;
+
+				char m_padding[_Internal::kRingBufferCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+			};
+
+
+			// Multi-Producer Single-Consumer Ring Buffer
+			// Push from any threads and pop from one thread.
+			// Pop is wait-free, so a real-time thread should be the consumer; push is lock-free (retries only when racing other producers).
+			// Capacity is rounded up to a power of two, and memory is allocated only in the constructor.
+			template <typename T>
+			class MPSCRingBuffer
+				: public SyntacticSugar::NonCopyable
+			{
+			public:
+				using ValueType = T;
+
+			public:
+				explicit MPSCRingBuffer(size_t capacity)
+					: m_capacity(_Internal::RoundUpRingBufferCapacity(capacity)), m_indexMask(m_capacity - 1)
+					, m_cells(new CellType[m_capacity])
+					, m_producerIndex(0), m_consumerIndex(0)
+				{
+					for (size_t i = 0; i < m_capacity; ++i)
+					{
+						m_cells[i].sequence.store(i, std::memory_order_relaxed);
+					}
+				}
+
+				~MPSCRingBuffer()
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_relaxed);
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					for (size_t i = consumerIndex; i != producerIndex; ++i)
+					{
+						CellType &cell = m_cells[i & m_indexMask];
+						if (cell.sequence.load(std::memory_order_acquire) == i + 1)
+						{
+							_Item(cell)->~T();
+						}
+					}
+				}
+
+			public:	// Producer Side
+				template <typename... ArgTs>
+				bool TryEmplace(ArgTs &&... args)
+				{
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					while (true)
+					{
+						CellType &cell = m_cells[producerIndex & m_indexMask];
+						size_t sequence = cell.sequence.load(std::memory_order_acquire);
+						intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(producerIndex);
+						if (difference == 0)
+						{
+							if (m_producerIndex.compare_exchange_weak(producerIndex, producerIndex + 1, std::memory_order_relaxed))
+							{
+								new (_Item(cell)) T(std::forward<ArgTs>(args)...);
+								cell.sequence.store(producerIndex + 1, std::memory_order_release);
+								return true;
+							}
+						}
+						else if (difference < 0)
+						{
+							// Full
+							return false;
+						}
+						else
+						{
+							// Other producer took it
+							producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+						}
+					}
+				}
+
+				bool TryPush(const T &item) { return TryEmplace(item); }
+				bool TryPush(T &&item) { return TryEmplace(std::move(item)); }
+
+				// Push items as many as free space by reserving a range at once, and returns the count of pushed items
+				// Pushed items stay contiguous, not interleaved with items of other producers.
+				size_t PushBulk(const T *items, size_t itemCount)
+				{
+					if (itemCount == 0)
+					{
+						return 0;
+					}
+
+					size_t producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+					size_t reserveCount = 0;
+					while (true)
+					{
+						size_t consumerIndex = m_consumerIndex.load(std::memory_order_acquire);
+						size_t usedCount = producerIndex - consumerIndex;
+						if (usedCount > m_capacity)
+						{
+							// Stale producer index
+							producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+							continue;
+						}
+
+						size_t freeCount = m_capacity - usedCount;
+						reserveCount = ((itemCount < freeCount) ? itemCount : freeCount);
+						if (reserveCount == 0)
+						{
+							return 0;
+						}
+
+						// The consumer frees cells in order, so the range is free if its last cell is
+						size_t lastIndex = producerIndex + reserveCount - 1;
+						size_t lastSequence = m_cells[lastIndex & m_indexMask].sequence.load(std::memory_order_acquire);
+						if (lastSequence != lastIndex)
+						{
+							producerIndex = m_producerIndex.load(std::memory_order_relaxed);
+							continue;
+						}
+
+						if (m_producerIndex.compare_exchange_weak(producerIndex, producerIndex + reserveCount, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+
+					for (size_t i = 0; i < reserveCount; ++i)
+					{
+						CellType &cell = m_cells[(producerIndex + i) & m_indexMask];
+						new (_Item(cell)) T(items[i]);
+						cell.sequence.store(producerIndex + i + 1, std::memory_order_release);
+					}
+					return reserveCount;
+				}
+
+			public:	// Consumer Side
+				bool TryPop(T &outItem)
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_relaxed);
+					CellType &cell = m_cells[consumerIndex & m_indexMask];
+					if (cell.sequence.load(std::memory_order_acquire) != consumerIndex + 1)
+					{
+						// Empty, or a producer is still writing
+						return false;
+					}
+
+					T *item = _Item(cell);
+					outItem = std::move(*item);
+					item->~T();
+
+					cell.sequence.store(consumerIndex + m_capacity, std::memory_order_release);
+					m_consumerIndex.store(consumerIndex + 1, std::memory_order_release);
+					return true;
+				}
+
+				// Pop items up to maxCount, and returns the count of popped items
+				size_t PopBulk(T *outItems, size_t maxCount)
+				{
+					size_t popCount = 0;
+					while (popCount < maxCount && TryPop(outItems[popCount]))
+					{
+						++popCount;
+					}
+					return popCount;
+				}
+
+			public:
+				size_t GetCapacity() const { return m_capacity; }
+
+				// Approximate, including items being written by producers
+				size_t GetSizeApprox() const
+				{
+					size_t consumerIndex = m_consumerIndex.load(std::memory_order_acquire);
+					size_t producerIndex = m_producerIndex.load(std::memory_order_acquire);
+					return ((producerIndex > consumerIndex) ? (producerIndex - consumerIndex) : 0);
+				}
+
+				bool IsEmptyApprox() const { return (GetSizeApprox() == 0); }
+
+			protected:
+				// A cell is free for index i when its sequence is i, and filled when i + 1
+				struct CellType
+				{
+				public:
+					std::atomic<size_t>												sequence;
+					typename std::aligned_storage<sizeof(T), alignof(T)>::type		storage;
+				};
+
+				static T *_Item(CellType &cell) { return reinterpret_cast<T *>(&cell.storage); }
+
+			protected:
+				const size_t					m_capacity;
+				const size_t					m_indexMask;
+				std::unique_ptr<CellType[]>		m_cells;
+
+				alignas(_Internal::kRingBufferCacheLineSize) std::atomic<size_t>	m_producerIndex;
+				alignas(_Internal::kRingBufferCacheLineSize) std::atomic<size_t>	m_consumerIndex;
+
+				char m_padding[_Internal::kRingBufferCacheLineSize - sizeof(std::atomic<size_t>)];
+			};
+		}
+	}
+}
+
+#endif
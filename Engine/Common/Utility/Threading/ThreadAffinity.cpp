@@ -0,0 +1,206 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/ThreadAffinity.cpp (Leggiero - Utility)
+//
+// Common Implementation of Thread Placement Utilites
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "ThreadAffinity.h"
+
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+			namespace _Internal
+			{
+				namespace
+				{
+					// Render thread gets its own core only with enough cores; otherwise it shares the game core
+					constexpr size_t kMinCoreCountForRenderCore = 6;
+
+					std::atomic_bool g_isThreadPlacementEnabled(false);
+					std::atomic_uint g_nextWorkerCoreIndex(0);
+
+					struct PhysicalCore
+					{
+					public:
+						std::vector<int>	logicalCPUs;
+						int					packageId;
+						int					coreId;
+						uint32_t			capacity;
+					};
+
+					struct ThreadPlacementPlan
+					{
+					public:
+						bool							isPlaceable;
+
+						std::vector<int>				gameCPUs;
+						std::vector<int>				renderCPUs;
+						std::vector<int>				schedulerCPUs;
+						std::vector<std::vector<int> >	workerCPUSets;
+					};
+
+					//------------------------------------------------------------------------------
+					CPUTopology MakeCPUTopology()
+					{
+						CPUTopology resultTopology;
+						if (ReadSystemCPUTopology(resultTopology) && !resultTopology.logicalCPUs.empty())
+						{
+							resultTopology.isFromSystem = true;
+							return resultTopology;
+						}
+
+						// Fallback: each logical CPU as a core of unknown capacity
+						resultTopology.logicalCPUs.clear();
+						resultTopology.isFromSystem = false;
+						int cpuCount = static_cast<int>(std::thread::hardware_concurrency());
+						for (int i = 0; i < cpuCount; ++i)
+						{
+							LogicalCPUInfo cpuInfo;
+							cpuInfo.cpuIndex = i;
+							cpuInfo.packageId = 0;
+							cpuInfo.coreId = i;
+							cpuInfo.capacity = 0;
+							resultTopology.logicalCPUs.push_back(cpuInfo);
+						}
+						return resultTopology;
+					}
+
+					//------------------------------------------------------------------------------
+					ThreadPlacementPlan BuildThreadPlacementPlan(const CPUTopology &topology)
+					{
+						ThreadPlacementPlan resultPlan;
+						resultPlan.isPlaceable = false;
+
+						// Group SMT siblings
+						std::vector<PhysicalCore> cores;
+						for (const LogicalCPUInfo &currentCPU : topology.logicalCPUs)
+						{
+							std::vector<PhysicalCore>::iterator coreIt = std::find_if(cores.begin(), cores.end(),
+								[&currentCPU](const PhysicalCore &core) { return (core.packageId == currentCPU.packageId && core.coreId == currentCPU.coreId); });
+							if (coreIt == cores.end())
+							{
+								PhysicalCore addingCore;
+								addingCore.packageId = currentCPU.packageId;
+								addingCore.coreId = currentCPU.coreId;
+								addingCore.capacity = currentCPU.capacity;
+								cores.push_back(addingCore);
+								coreIt = cores.end() - 1;
+							}
+							coreIt->logicalCPUs.push_back(currentCPU.cpuIndex);
+							coreIt->capacity = std::max(coreIt->capacity, currentCPU.capacity);
+						}
+
+						if (cores.size() < 2)
+						{
+							// Nothing to separate
+							return resultPlan;
+						}
+
+						// Fastest cores first; game and render threads are latency critical
+						std::stable_sort(cores.begin(), cores.end(), [](const PhysicalCore &lhs, const PhysicalCore &rhs) { return lhs.capacity > rhs.capacity; });
+
+						size_t reservedCoreCount = 1;
+						resultPlan.gameCPUs = cores[0].logicalCPUs;
+						if (cores.size() >= kMinCoreCountForRenderCore)
+						{
+							resultPlan.renderCPUs = cores[1].logicalCPUs;
+							reservedCoreCount = 2;
+						}
+						else
+						{
+							resultPlan.renderCPUs = cores[0].logicalCPUs;
+						}
+
+						for (size_t i = reservedCoreCount; i < cores.size(); ++i)
+						{
+							resultPlan.workerCPUSets.push_back(cores[i].logicalCPUs);
+							resultPlan.schedulerCPUs.insert(resultPlan.schedulerCPUs.end(), cores[i].logicalCPUs.begin(), cores[i].logicalCPUs.end());
+						}
+
+						resultPlan.isPlaceable = true;
+						return resultPlan;
+					}
+
+					//------------------------------------------------------------------------------
+					const ThreadPlacementPlan &GetThreadPlacementPlan()
+					{
+						static const ThreadPlacementPlan plan(BuildThreadPlacementPlan(GetCPUTopology()));
+						return plan;
+					}
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Thread Placement
+
+			//------------------------------------------------------------------------------
+			// Get topology read at the first call
+			const CPUTopology &GetCPUTopology()
+			{
+				static const CPUTopology topology(_Internal::MakeCPUTopology());
+				return topology;
+			}
+
+			//------------------------------------------------------------------------------
+			void SetThreadPlacementEnabled(bool isEnabled)
+			{
+				_Internal::g_isThreadPlacementEnabled.store(isEnabled);
+			}
+
+			//------------------------------------------------------------------------------
+			bool IsThreadPlacementEnabled()
+			{
+				return _Internal::g_isThreadPlacementEnabled.load(std::memory_order_relaxed);
+			}
+
+			//------------------------------------------------------------------------------
+			// Place current thread by its role, if placement enabled
+			bool PlaceCurrentThread(ThreadPlacementRole role)
+			{
+				if (!IsThreadPlacementEnabled() || !IsThreadAffinitySupported())
+				{
+					return false;
+				}
+
+				const _Internal::ThreadPlacementPlan &plan = _Internal::GetThreadPlacementPlan();
+				if (!plan.isPlaceable)
+				{
+					return false;
+				}
+
+				switch (role)
+				{
+					case ThreadPlacementRole::kGame:
+						return SetCurrentThreadAffinity(plan.gameCPUs);
+
+					case ThreadPlacementRole::kRender:
+						return SetCurrentThreadAffinity(plan.renderCPUs);
+
+					case ThreadPlacementRole::kTaskWorker:
+						{
+							// One core per worker in turn, so workers do not migrate
+							unsigned int coreIndex = _Internal::g_nextWorkerCoreIndex.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned int>(plan.workerCPUSets.size());
+							return SetCurrentThreadAffinity(plan.workerCPUSets[coreIndex]);
+						}
+
+					case ThreadPlacementRole::kTaskScheduler:
+						return SetCurrentThreadAffinity(plan.schedulerCPUs);
+				}
+
+				return false;
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/ThreadAffinity.h (Leggiero - Utility)
+//
+// CPU Topology and Thread Placement Utilites
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __UTILITY__THREADING__THREAD_AFFINITY_H
+#define __UTILITY__THREADING__THREAD_AFFINITY_H
+
+
+// Standard Library
+#include <cstdint>
+#include <vector>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			// Description of a logical CPU
+			struct LogicalCPUInfo
+			{
+			public:
+				int			cpuIndex;
+
+				// Logical CPUs of the same package and core id are SMT siblings
+				int			packageId;
+				int			coreId;
+
+				// Relative performance; cpu_capacity or max frequency in kHz. 0 if unknown
+				uint32_t	capacity;
+			};
+
+
+			// Online logical CPUs of the system
+			struct CPUTopology
+			{
+			public:
+				std::vector<LogicalCPUInfo>	logicalCPUs;
+
+				// false if estimated by the fallback without any system description
+				bool						isFromSystem;
+			};
+
+
+			// Roles of threads, placed to different cores
+			enum class ThreadPlacementRole
+			{
+				kGame,
+				kRender,
+				kTaskWorker,
+				kTaskScheduler,
+			};
+
+
+			// Get topology read at the first call
+			const CPUTopology &GetCPUTopology();
+
+			// Read topology from the system description; returns false if not available on the platform
+			bool ReadSystemCPUTopology(CPUTopology &outTopology);
+
+			// Is it possible to set affinity of threads on this platform?
+			bool IsThreadAffinitySupported();
+
+			// Restrict current thread to given logical CPUs; returns false if not applied
+			bool SetCurrentThreadAffinity(const std::vector<int> &logicalCPUIndices);
+
+
+			// Thread placement is off by default; turn on before threads to be placed start
+			void SetThreadPlacementEnabled(bool isEnabled);
+			bool IsThreadPlacementEnabled();
+
+			// Place current thread by its role, if placement enabled
+			// Game and render threads get their own cores, and task workers spread over the rest one by one.
+			// Returns false if not placed (disabled, unsupported, or too few cores).
+			bool PlaceCurrentThread(ThreadPlacementRole role);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,195 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/ThreadAffinity_Android.cpp (Leggiero - Utility)
+//
+// Android Platform Implementation of Thread Placement Utilites
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "ThreadAffinity.h"
+
+// Standard Library
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// External Library
+#include <sched.h>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+			namespace _Internal
+			{
+				namespace
+				{
+					const char *kSystemCPUPath = "/sys/devices/system/cpu";
+
+					//------------------------------------------------------------------------------
+					// Read first line of a sysfs file
+					bool ReadSystemFileLine(const std::string &filePath, std::string &outLine)
+					{
+						FILE *fp = fopen(filePath.c_str(), "r");
+						if (fp == nullptr)
+						{
+							return false;
+						}
+
+						char lineBuffer[256];
+						bool isRead = (fgets(lineBuffer, sizeof(lineBuffer), fp) != nullptr);
+						fclose(fp);
+						if (!isRead)
+						{
+							return false;
+						}
+
+						outLine = lineBuffer;
+						while (!outLine.empty() && (outLine.back() == '\n' || outLine.back() == '\r' || outLine.back() == ' '))
+						{
+							outLine.pop_back();
+						}
+						return true;
+					}
+
+					//------------------------------------------------------------------------------
+					bool ReadSystemFileInteger(const std::string &filePath, long &outValue)
+					{
+						std::string readLine;
+						if (!ReadSystemFileLine(filePath, readLine) || readLine.empty())
+						{
+							return false;
+						}
+
+						char *parseEnd = nullptr;
+						outValue = strtol(readLine.c_str(), &parseEnd, 10);
+						return (parseEnd != readLine.c_str());
+					}
+
+					//------------------------------------------------------------------------------
+					// Parse cpu list format like "0-3,6,8-9"
+					std::vector<int> ParseCPUList(const std::string &cpuList)
+					{
+						std::vector<int> resultList;
+
+						const char *parsing = cpuList.c_str();
+						while (*parsing != '\0')
+						{
+							char *parseEnd = nullptr;
+							long rangeBegin = strtol(parsing, &parseEnd, 10);
+							if (parseEnd == parsing)
+							{
+								break;
+							}
+							long rangeEnd = rangeBegin;
+							parsing = parseEnd;
+
+							if (*parsing == '-')
+							{
+								++parsing;
+								rangeEnd = strtol(parsing, &parseEnd, 10);
+								if (parseEnd == parsing)
+								{
+									break;
+								}
+								parsing = parseEnd;
+							}
+
+							for (long i = rangeBegin; i <= rangeEnd && i < CPU_SETSIZE; ++i)
+							{
+								resultList.push_back(static_cast<int>(i));
+							}
+
+							if (*parsing == ',')
+							{
+								++parsing;
+							}
+						}
+
+						return resultList;
+					}
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Thread Placement
+
+			//------------------------------------------------------------------------------
+			// Read topology from /sys/devices/system/cpu
+			bool ReadSystemCPUTopology(CPUTopology &outTopology)
+			{
+				outTopology.logicalCPUs.clear();
+
+				std::string onlineList;
+				if (!_Internal::ReadSystemFileLine(std::string(_Internal::kSystemCPUPath) + "/online", onlineList))
+				{
+					return false;
+				}
+
+				std::vector<int> onlineCPUs = _Internal::ParseCPUList(onlineList);
+				for (int cpuIndex : onlineCPUs)
+				{
+					std::string cpuPath = std::string(_Internal::kSystemCPUPath) + "/cpu" + std::to_string(cpuIndex);
+
+					LogicalCPUInfo cpuInfo;
+					cpuInfo.cpuIndex = cpuIndex;
+
+					long readValue = 0;
+					cpuInfo.packageId = (_Internal::ReadSystemFileInteger(cpuPath + "/topology/physical_package_id", readValue) ? static_cast<int>(readValue) : 0);
+					cpuInfo.coreId = (_Internal::ReadSystemFileInteger(cpuPath + "/topology/core_id", readValue) ? static_cast<int>(readValue) : cpuIndex);
+
+					// Prefer scheduler capacity of heterogeneous cores, then max frequency
+					if (_Internal::ReadSystemFileInteger(cpuPath + "/cpu_capacity", readValue) && readValue > 0)
+					{
+						cpuInfo.capacity = static_cast<uint32_t>(readValue);
+					}
+					else if (_Internal::ReadSystemFileInteger(cpuPath + "/cpufreq/cpuinfo_max_freq", readValue) && readValue > 0)
+					{
+						cpuInfo.capacity = static_cast<uint32_t>(readValue);
+					}
+					else
+					{
+						cpuInfo.capacity = 0;
+					}
+
+					outTopology.logicalCPUs.push_back(cpuInfo);
+				}
+
+				return !outTopology.logicalCPUs.empty();
+			}
+
+			//------------------------------------------------------------------------------
+			bool IsThreadAffinitySupported()
+			{
+				return true;
+			}
+
+			//------------------------------------------------------------------------------
+			// Restrict current thread to given logical CPUs; returns false if not applied
+			bool SetCurrentThreadAffinity(const std::vector<int> &logicalCPUIndices)
+			{
+				if (logicalCPUIndices.empty())
+				{
+					return false;
+				}
+
+				cpu_set_t cpuSet;
+				CPU_ZERO(&cpuSet);
+				for (int cpuIndex : logicalCPUIndices)
+				{
+					if (cpuIndex >= 0 && cpuIndex < CPU_SETSIZE)
+					{
+						CPU_SET(cpuIndex, &cpuSet);
+					}
+				}
+
+				// pid 0 means the calling thread
+				return (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0);
+			}
+		}
+	}
+}
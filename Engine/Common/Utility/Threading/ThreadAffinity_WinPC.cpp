@@ -0,0 +1,56 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/ThreadAffinity_WinPC.cpp (Leggiero - Utility)
+//
+// Windows PC Platform Implementation of Thread Placement Utilites
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "ThreadAffinity.h"
+
+// External Library
+#define NOMINMAX
+#include <Windows.h>
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			//------------------------------------------------------------------------------
+			// No system description read; the common fallback by hardware concurrency is used
+			bool ReadSystemCPUTopology(CPUTopology &outTopology)
+			{
+				outTopology.logicalCPUs.clear();
+				return false;
+			}
+
+			//------------------------------------------------------------------------------
+			bool IsThreadAffinitySupported()
+			{
+				return true;
+			}
+
+			//------------------------------------------------------------------------------
+			// Restrict current thread to given logical CPUs; returns false if not applied
+			bool SetCurrentThreadAffinity(const std::vector<int> &logicalCPUIndices)
+			{
+				DWORD_PTR affinityMask = 0;
+				for (int cpuIndex : logicalCPUIndices)
+				{
+					if (cpuIndex >= 0 && cpuIndex < static_cast<int>(sizeof(DWORD_PTR) * 8))
+					{
+						affinityMask |= (static_cast<DWORD_PTR>(1) << cpuIndex);
+					}
+				}
+				if (affinityMask == 0)
+				{
+					return false;
+				}
+
+				return (SetThreadAffinityMask(GetCurrentThread(), affinityMask) != 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,39 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Threading/ThreadAffinity_iOS.cpp (Leggiero - Utility)
+//
+// iOS Platform Implementation of Thread Placement Utilites
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "ThreadAffinity.h"
+
+
+namespace Leggiero
+{
+	namespace Utility
+	{
+		namespace Threading
+		{
+			//------------------------------------------------------------------------------
+			// No system description read; the common fallback by hardware concurrency is used
+			bool ReadSystemCPUTopology(CPUTopology &outTopology)
+			{
+				outTopology.logicalCPUs.clear();
+				return false;
+			}
+
+			//------------------------------------------------------------------------------
+			// iOS does not provide thread affinity; placement is left to the system
+			bool IsThreadAffinitySupported()
+			{
+				return false;
+			}
+
+			//------------------------------------------------------------------------------
+			bool SetCurrentThreadAffinity(const std::vector<int> &/*logicalCPUIndices*/)
+			{
+				return false;
+			}
+		}
+	}
+}
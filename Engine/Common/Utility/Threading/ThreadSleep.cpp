@@ -37,7 +37,14 @@ namespace Leggiero
 			// Get system time as timespec from epoch
 			timespec GetCurrentSystemTimespec()
 			{
-				std::chrono::nanoseconds durationInNS(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()));
+				return ToSystemTimespec(std::chrono::system_clock::now());
+			}
+
+			//------------------------------------------------------------------------------
+			// Get given system clock time point as timespec from epoch
+			timespec ToSystemTimespec(const std::chrono::system_clock::time_point &timePoint)
+			{
+				std::chrono::nanoseconds durationInNS(std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()));
 
 				timespec resultValue;
 				if (durationInNS.count() <= 0)
@@ -8,6 +8,9 @@
 #define __UTILITY__THREADING__THREAD_SLEEP_H
 
 
+// Standard Library
+#include <chrono>
+
 // External Library
 #include <pthread.h>
 
@@ -34,6 +37,9 @@ namespace Leggiero
 			// Get system time as timespec from epoch
 			timespec GetCurrentSystemTimespec();
 
+			// Get given system clock time point as timespec from epoch
+			timespec ToSystemTimespec(const std::chrono::system_clock::time_point &timePoint);
+
 			// Add two duration represented by timespec struct
 			inline timespec TimespecAdd(const timespec &t1, const timespec &t2)
 			{
@@ -9,6 +9,7 @@
 
 // Standard Library
 #include <cmath>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -583,29 +584,30 @@ namespace Leggiero
 				return TextAlignType::kDefault;
 			}
 
-			if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "Justify")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "J"))
+			std::string_view alignmentView(alignmentString);
+			if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "Justify")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "J"))
 			{
 				return TextAlignType::kJustify;
 			}
-			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "L")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "Left"))
+			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "L")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "Left"))
 			{
 				return TextAlignType::kLeft;
 			}
-			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "C")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "Center"))
+			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "C")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "Center"))
 			{
 				return TextAlignType::kCenter;
 			}
-			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "R")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "Right"))
+			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "R")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "Right"))
 			{
 				return TextAlignType::kRight;
 			}
-			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "JustifyWord")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "JW")
-				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentString, "JustifyW"))
+			else if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "JustifyWord")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "JW")
+				|| Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(alignmentView, "JustifyW"))
 			{
 				return TextAlignType::kJustifyWord;
 			}
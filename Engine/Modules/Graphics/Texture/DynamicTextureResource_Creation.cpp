@@ -1,4 +1,4 @@
-////////////////////////////////////////////////////////////////////////////////
+﻿////////////////////////////////////////////////////////////////////////////////
 // Texture/DynamicTextureResource_Creation.cpp (Leggiero/Modules - Graphics)
 //
 // Implementation of Creation Functions of Dynamic Texture Resource
@@ -75,6 +75,7 @@ namespace Leggiero
 			if (creatingData == nullptr && imageData != nullptr)
 			{
 				glTexSubImage2D(GL_TEXTURE_2D, mipmapLevel, 0, 0, imageWidth, imageHeight, format, dataType, imageData);
+				Texture::ReportTextureUpload(imageWidth, imageHeight, format, dataType);
                 #ifdef _LEGGIERO_IOS
                     glFlush();
                 #else
@@ -1,4 +1,4 @@
-////////////////////////////////////////////////////////////////////////////////
+﻿////////////////////////////////////////////////////////////////////////////////
 // Texture/RenderTargetTextureResource_Creation.cpp (Leggiero/Modules - Graphics)
 //
 // Implementation of Creation Functions of Render Target Texture Resource
@@ -131,6 +131,7 @@ namespace Leggiero
 			if (creatingData == nullptr && imageData != nullptr)
 			{
 				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, imageWidth, imageHeight, GL_RGBA, GL_UNSIGNED_BYTE, imageData);
+				Texture::ReportTextureUpload(imageWidth, imageHeight, GL_RGBA, GL_UNSIGNED_BYTE);
                 #ifdef _LEGGIERO_IOS
                     glFlush();
                 #else
@@ -7,6 +7,9 @@
 // My Header
 #include "TextureHelper.h"
 
+// Standard Library
+#include <atomic>
+
 
 namespace Leggiero
 {
@@ -14,6 +17,12 @@ namespace Leggiero
 	{
 		namespace Texture
 		{
+			namespace
+			{
+				std::atomic<TextureUploadReporterType> g_textureUploadReporter(nullptr);
+			}
+
+
 			//////////////////////////////////////////////////////////////////////////////// GLESRawTextureInformation
 			
 			//------------------------------------------------------------------------------
@@ -119,6 +128,26 @@ namespace Leggiero
 
 				return false;
 			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Upload Report
+
+			//------------------------------------------------------------------------------
+			void SetTextureUploadReporter(TextureUploadReporterType reporter)
+			{
+				g_textureUploadReporter.store(reporter, std::memory_order_release);
+			}
+
+			//------------------------------------------------------------------------------
+			void ReportTextureUpload(GLsizei width, GLsizei height, GLenum format, GLenum dataType)
+			{
+				TextureUploadReporterType reporter = g_textureUploadReporter.load(std::memory_order_acquire);
+				if (reporter == nullptr || width <= 0 || height <= 0)
+				{
+					return;
+				}
+				reporter(static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(GetTexelByteSize(format, dataType)));
+			}
 		}
 	}
 }
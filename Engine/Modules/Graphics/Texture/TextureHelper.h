@@ -12,6 +12,7 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standard Library
+#include <cstddef>
 #include <iostream>
 #include <string>
 
@@ -58,6 +59,14 @@ namespace Leggiero
 			bool HasFormatAlpha(GLenum format);
 
 
+			// Reporter of image bytes uploaded to textures, called on the uploading thread
+			// Task module installs one to count uploads in graphic tasks for the frame budget.
+			using TextureUploadReporterType = void (*)(size_t uploadBytes);
+			void SetTextureUploadReporter(TextureUploadReporterType reporter);
+
+			void ReportTextureUpload(GLsizei width, GLsizei height, GLenum format, GLenum dataType);
+
+
 			namespace Loader
 			{
 				// Texture Loader
@@ -1,4 +1,4 @@
-////////////////////////////////////////////////////////////////////////////////
+﻿////////////////////////////////////////////////////////////////////////////////
 // Texture/TextureHelper_Loader.cpp (Leggiero/Modules - Graphics)
 //
 // Loader part of Texture Helper Implementations
@@ -169,9 +169,14 @@ namespace Leggiero
 					}
 
 					glTexImage2D(GL_TEXTURE_2D, mipmapLevel, format, effectiveWidth, effectiveHeight, 0, format, dataType, creatingData);
-					if (creatingData == nullptr && data != nullptr)
+					if (creatingData != nullptr)
+					{
+						ReportTextureUpload(effectiveWidth, effectiveHeight, format, dataType);
+					}
+					else if (data != nullptr)
 					{
 						glTexSubImage2D(GL_TEXTURE_2D, mipmapLevel, 0, 0, width, height, format, dataType, data);
+						ReportTextureUpload(width, height, format, dataType);
 					}
 					if (glGetError() != GL_NO_ERROR)
 					{
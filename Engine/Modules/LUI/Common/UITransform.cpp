@@ -34,7 +34,7 @@ namespace Leggiero
 
 		//////////////////////////////////////////////////////////////////////////////// IdentityTransform
 
-		moodycamel::ConcurrentQueue<std::shared_ptr<IdentityTransform> > IdentityTransform::ms_transformPool;
+		Utility::Object::SharedObjectPool<IdentityTransform> IdentityTransform::ms_transformPool;
 
 		//------------------------------------------------------------------------------
 		std::shared_ptr<IUITransform> IdentityTransform::Combine(std::shared_ptr<IUITransform> rhs)
@@ -49,30 +49,19 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		std::shared_ptr<IdentityTransform> IdentityTransform::AllocateTransform()
 		{
-			std::shared_ptr<IdentityTransform> transformEntry;
-			if (ms_transformPool.try_dequeue(transformEntry))
-			{
-				return transformEntry;
-			}
-			else
-			{
-				return std::make_shared<IdentityTransform>();
-			}
+			return ms_transformPool.GetObject();
 		}
 
 		//------------------------------------------------------------------------------
 		void IdentityTransform::ReleaseTransform(std::shared_ptr<IdentityTransform> transformToRelease)
 		{
-			if (transformToRelease)
-			{
-				ms_transformPool.enqueue(transformToRelease);
-			}
+			ms_transformPool.ReleaseObject(transformToRelease);
 		}
 
 
 		//////////////////////////////////////////////////////////////////////////////// OffsetTransform
 
-		moodycamel::ConcurrentQueue<std::shared_ptr<OffsetTransform> > OffsetTransform::ms_transformPool;
+		Utility::Object::SharedObjectPool<OffsetTransform> OffsetTransform::ms_transformPool;
 
 		//------------------------------------------------------------------------------
 		std::shared_ptr<IUITransform> OffsetTransform::Combine(std::shared_ptr<IUITransform> rhs)
@@ -113,8 +102,8 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		std::shared_ptr<OffsetTransform> OffsetTransform::AllocateTransform(UICoordinateType xOffset, UICoordinateType yOffset)
 		{
-			std::shared_ptr<OffsetTransform> transformEntry;
-			if (ms_transformPool.try_dequeue(transformEntry))
+			std::shared_ptr<OffsetTransform> transformEntry(ms_transformPool.GetObject());
+			if (transformEntry)
 			{
 				transformEntry->m_xOffset = xOffset;
 				transformEntry->m_yOffset = yOffset;
@@ -129,16 +118,14 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void OffsetTransform::ReleaseTransform(std::shared_ptr<OffsetTransform> transformToRelease)
 		{
-			if (transformToRelease)
-			{
-				ms_transformPool.enqueue(transformToRelease);
-			}
+			ms_transformPool.ReleaseObject(transformToRelease);
 		}
 
 
 		//////////////////////////////////////////////////////////////////////////////// UICombinedTransform
 
-		moodycamel::ConcurrentQueue<std::shared_ptr<UICombinedTransform> > UICombinedTransform::ms_transformPool;
+		Utility::Object::SharedObjectPool<UICombinedTransform> UICombinedTransform::ms_transformPool(Utility::Object::SharedObjectPool<UICombinedTransform>::kDefaultCapacity,
+			[](UICombinedTransform &transformToReset) { transformToReset.m_pre.reset(); transformToReset.m_post.reset(); });
 
 		//------------------------------------------------------------------------------
 		UICombinedTransform::UICombinedTransform(std::shared_ptr<IUITransform> pre, std::shared_ptr<IUITransform> post)
@@ -163,8 +150,8 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		std::shared_ptr<UICombinedTransform> UICombinedTransform::AllocateTransform(std::shared_ptr<IUITransform> pre, std::shared_ptr<IUITransform> post)
 		{
-			std::shared_ptr<UICombinedTransform> transformEntry;
-			if (ms_transformPool.try_dequeue(transformEntry))
+			std::shared_ptr<UICombinedTransform> transformEntry(ms_transformPool.GetObject());
+			if (transformEntry)
 			{
 				transformEntry->m_pre = pre;
 				transformEntry->m_post = post;
@@ -179,12 +166,7 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void UICombinedTransform::ReleaseTransform(std::shared_ptr<UICombinedTransform> transformToRelease)
 		{
-			if (transformToRelease)
-			{
-				transformToRelease->m_pre.reset();
-				transformToRelease->m_post.reset();
-				ms_transformPool.enqueue(transformToRelease);
-			}
+			ms_transformPool.ReleaseObject(transformToRelease);
 		}
 
 
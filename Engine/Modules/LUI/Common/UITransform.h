@@ -12,10 +12,12 @@
 #include <memory>
 
 // External Library
-#include <concurrentqueue/concurrentqueue.h>
 #define GLM_FORCE_RADIANS
 #include <glm/glm.hpp>
 
+// Leggiero.Utility
+#include <Utility/Object/ObjectPool.h>
+
 // Leggiero.LegacyUI
 #include "UICommonTypes.h"
 
@@ -62,7 +64,7 @@ namespace Leggiero
 			static void ReleaseTransform(std::shared_ptr<IdentityTransform> transformToRelease);
 
 		protected:
-			static moodycamel::ConcurrentQueue<std::shared_ptr<IdentityTransform> > ms_transformPool;
+			static Utility::Object::SharedObjectPool<IdentityTransform> ms_transformPool;
 		};
 
 
@@ -100,7 +102,7 @@ namespace Leggiero
 			static void ReleaseTransform(std::shared_ptr<OffsetTransform> transformToRelease);
 
 		protected:
-			static moodycamel::ConcurrentQueue<std::shared_ptr<OffsetTransform> > ms_transformPool;
+			static Utility::Object::SharedObjectPool<OffsetTransform> ms_transformPool;
 		};
 
 
@@ -129,7 +131,7 @@ namespace Leggiero
 			static void ReleaseTransform(std::shared_ptr<UICombinedTransform> transformToRelease);
 
 		protected:
-			static moodycamel::ConcurrentQueue<std::shared_ptr<UICombinedTransform> > ms_transformPool;
+			static Utility::Object::SharedObjectPool<UICombinedTransform> ms_transformPool;
 		};
 
 
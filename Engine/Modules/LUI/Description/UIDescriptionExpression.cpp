@@ -461,7 +461,7 @@ namespace Leggiero
 							std::vector<std::string> argumentTokens = Utility::String::ASCIIStringUtility::Tokenize(std::get<2>(callTuple), { ',' });
 							for (size_t i = 0; i < argumentTokens.size(); ++i)
 							{
-								argumentTokens[i] = Utility::String::ASCIIStringUtility::StringTrim(argumentTokens[i]);
+								Utility::String::ASCIIStringUtility::StringTrimInPlace(argumentTokens[i]);
 							}
 							if (Utility::String::ASCIIStringUtility::IsSameStringNonCaseSensitive(colorConstructor, "argb"))
 							{
@@ -561,7 +561,8 @@ namespace Leggiero
 							isForceFloatValues = true;
 						}
 
-						tokenValues[i] = static_cast<float>(ParseFloatingPointValueFromString(Utility::String::ASCIIStringUtility::StringTrim(tupleTokens[i]).c_str()));
+						Utility::String::ASCIIStringUtility::StringTrimInPlace(tupleTokens[i]);
+						tokenValues[i] = static_cast<float>(ParseFloatingPointValueFromString(tupleTokens[i].c_str()));
 						if (tokenValues[i] < 0.0f)
 						{
 							tokenValues[i] = 0.0f;
@@ -620,7 +621,7 @@ namespace Leggiero
 							std::vector<std::string> argumentTokens = Utility::String::ASCIIStringUtility::Tokenize(std::get<2>(callTuple), { ',' });
 							for (size_t i = 0; i < argumentTokens.size(); ++i)
 							{
-								argumentTokens[i] = Utility::String::ASCIIStringUtility::StringTrim(argumentTokens[i]);
+								Utility::String::ASCIIStringUtility::StringTrimInPlace(argumentTokens[i]);
 							}
 							if (Utility::String::ASCIIStringUtility::IsStartWithNonCaseSensitive(vectorConstructor, "vec"))
 							{
@@ -699,7 +700,7 @@ namespace Leggiero
 							std::vector<std::string> argumentTokens = Utility::String::ASCIIStringUtility::Tokenize(std::get<2>(callTuple), { ',' });
 							for (size_t i = 0; i < argumentTokens.size(); ++i)
 							{
-								argumentTokens[i] = Utility::String::ASCIIStringUtility::StringTrim(argumentTokens[i]);
+								Utility::String::ASCIIStringUtility::StringTrimInPlace(argumentTokens[i]);
 							}
 							if (Utility::String::ASCIIStringUtility::IsStartWithNonCaseSensitive(vectorConstructor, "vec2")
 								|| Utility::String::ASCIIStringUtility::IsStartWithNonCaseSensitive(vectorConstructor, "vector2"))
@@ -58,8 +58,9 @@ namespace Leggiero
 							return std::make_tuple(false, std::string(), std::string());
 						}
 
-						std::string constructorString(Utility::String::ASCIIStringUtility::StringTrim(expressionStr.substr(0, firstParenthesesPosition)));
-						std::string argumentString(Utility::String::ASCIIStringUtility::StringTrim(expressionStr.substr(firstParenthesesPosition + 1, firstParenthesesFinishPosition - firstParenthesesPosition - 1)));
+						std::string_view expressionView(expressionStr);
+						std::string constructorString(Utility::String::ASCIIStringUtility::StringTrimView(expressionView.substr(0, firstParenthesesPosition)));
+						std::string argumentString(Utility::String::ASCIIStringUtility::StringTrimView(expressionView.substr(firstParenthesesPosition + 1, firstParenthesesFinishPosition - firstParenthesesPosition - 1)));
 
 						return std::make_tuple(true, constructorString, argumentString);
 					}
@@ -9,6 +9,7 @@
 
 // Leggiero.Utility
 #include <Utility/Math/Vector.h>
+#include <Utility/Object/FrameArena.h>
 
 
 namespace Leggiero
@@ -124,7 +125,10 @@ namespace Leggiero
 				bool isPassPointExists = false;
 				bool isRejectPointExists = false;
 
-				std::vector<PointCollectingEntry> processingPolygon;
+				// Working polygons are scratch data, freed all at once when leaving
+				Utility::Object::FrameArenaScope scratchScope;
+
+				Utility::Object::FrameArenaVector<PointCollectingEntry> processingPolygon;
 				processingPolygon.reserve(targetPolygon.size() + 4);
 
 				for (const PointT &currentPolygonPoint : targetPolygon)
@@ -234,7 +238,7 @@ namespace Leggiero
 				}
 
 				// Cut by Edges
-				std::vector<PointT> lerpReferencer;
+				Utility::Object::FrameArenaVector<PointT> lerpReferencer;
 				for (size_t i = 0; i < clippingPolygonPointCount; ++i)
 				{
 					const UIVector2D &clipPoint1 = clippingPolygon[i];
@@ -411,7 +415,7 @@ namespace Leggiero
 								lerpReferencer.push_back(targetPoint1.point.LerpWith(targetPoint2.point, lerpParam));
 
 								// Push After Start
-								typename std::vector<PointCollectingEntry>::iterator insertPoitionIt = processingPolygon.begin() + startPointInsertIndex;
+								typename Utility::Object::FrameArenaVector<PointCollectingEntry>::iterator insertPoitionIt = processingPolygon.begin() + startPointInsertIndex;
 								processingPolygon.insert(insertPoitionIt, PointCollectingEntry(lerpReferencer[lerpReferencer.size() - 1], startCrossingPoint, true));
 
 								++finishingPeriod;
@@ -447,7 +451,7 @@ namespace Leggiero
 								lerpReferencer.push_back(finishLinePoint1.point.LerpWith(finishLinePoint2.point, lerpParam));
 
 								// Push After Finish
-								typename std::vector<PointCollectingEntry>::iterator insertPoitionIt = processingPolygon.begin() + finishPointInsertIndex;
+								typename Utility::Object::FrameArenaVector<PointCollectingEntry>::iterator insertPoitionIt = processingPolygon.begin() + finishPointInsertIndex;
 								processingPolygon.insert(insertPoitionIt, PointCollectingEntry(lerpReferencer[lerpReferencer.size() - 1], finishCrossingPoint, true));
 
 								if (rejectSegment1Start >= finishPointInsertIndex)
@@ -12,6 +12,7 @@
 #include <unordered_set>
 
 // Leggiero.Utility
+#include <Utility/Object/FrameArena.h>
 #include <Utility/Sugar/Finally.h>
 
 // Leggiero.Application
@@ -48,6 +49,7 @@ namespace Leggiero
 			, m_objectIdIssuer(1)
 			, m_isInputDialogWaiting(false)
 			, m_isInitialized(false), m_isPaused(false)
+			, m_layoutInformationObjectPool(kLayoutInformationPoolCapacity, [](CalculatedUILayoutInformation &informationObject) { informationObject.ResetInformation(); })
 		{
 		}
 
@@ -425,30 +427,25 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		std::shared_ptr<CalculatedUILayoutInformation> UIManager::_AllocateLayoutInformationObject()
 		{
-			if (m_layoutInformationObjectPool.empty())
-			{
-				return std::make_shared<CalculatedUILayoutInformation>();
-			}
-			else
-			{
-				std::shared_ptr<CalculatedUILayoutInformation> pooledObject(m_layoutInformationObjectPool.front());
-				pooledObject->ResetInformation();
-				m_layoutInformationObjectPool.pop_front();
-				return pooledObject;
-			}
+			// Pooled objects are reset when released
+			return m_layoutInformationObjectPool.GetObject();
 		}
 
 		//------------------------------------------------------------------------------
 		void UIManager::_ReleaseLayoutInformationObject(std::shared_ptr<CalculatedUILayoutInformation> toRelease)
 		{
-			m_layoutInformationObjectPool.push_front(toRelease);
+			m_layoutInformationObjectPool.ReleaseObject(toRelease);
 		}
 
 		//------------------------------------------------------------------------------
 		// * Should be called in update lock context
 		void UIManager::_BuildLayoutTable()
 		{
-			std::unordered_set<UIObjectIdType> inTreeLayoutingObjects;
+			// Id sets are only for this build, so take them from the frame arena
+			Utility::Object::FrameArenaScope scratchScope;
+
+			std::unordered_set<UIObjectIdType, std::hash<UIObjectIdType>, std::equal_to<UIObjectIdType>, Utility::Object::FrameArenaAllocator<UIObjectIdType> > inTreeLayoutingObjects;
+			inTreeLayoutingObjects.reserve(m_frameLayoutInformationTable.size());
 			m_root->IterateUIJob(
 				[this, &inTreeLayoutingObjects](std::shared_ptr<UIObject> target) {
 					if (target->IsVisible())
@@ -476,7 +473,7 @@ namespace Leggiero
 				);
 			if (inTreeLayoutingObjects.size() != m_frameLayoutInformationTable.size())
 			{
-				std::vector<UIObjectIdType> notInTreeObjects;
+				Utility::Object::FrameArenaVector<UIObjectIdType> notInTreeObjects;
 				notInTreeObjects.reserve(m_frameLayoutInformationTable.size());
 				for (std::unordered_map<UIObjectIdType, std::shared_ptr<CalculatedUILayoutInformation> >::iterator it = m_frameLayoutInformationTable.begin(); it != m_frameLayoutInformationTable.end(); ++it)
 				{
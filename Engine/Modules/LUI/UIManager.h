@@ -14,7 +14,6 @@
 // Standard Library
 #include <atomic>
 #include <functional>
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -23,6 +22,7 @@
 #include <concurrentqueue/concurrentqueue.h>
 
 // Leggiero.Utility
+#include <Utility/Object/ObjectPool.h>
 #include <Utility/Sugar/NonCopyable.h>
 #include <Utility/Threading/ManagedThreadPrimitives.h>
 
@@ -141,6 +141,8 @@ namespace Leggiero
 			std::shared_ptr<CalculatedUILayoutInformation> FindFrameCachedLayoutInformation(UIObjectIdType objectId);
 
 		protected:
+			static constexpr size_t kLayoutInformationPoolCapacity = 1024;
+
 			std::shared_ptr<CalculatedUILayoutInformation> _AllocateLayoutInformationObject();
 			void _ReleaseLayoutInformationObject(std::shared_ptr<CalculatedUILayoutInformation> toRelease);
 
@@ -162,7 +164,7 @@ namespace Leggiero
 			std::shared_ptr<UITouchNegotiator>	m_touchNegotiator;
 
 			std::unordered_map<UIObjectIdType, std::shared_ptr<CalculatedUILayoutInformation> >	m_frameLayoutInformationTable;
-			std::list<std::shared_ptr<CalculatedUILayoutInformation> >							m_layoutInformationObjectPool;
+			Utility::Object::SharedObjectPool<CalculatedUILayoutInformation>						m_layoutInformationObjectPool;
 
 			moodycamel::ConcurrentQueue<DelayedUIAction> m_delayedActionQueue;
 
@@ -9,10 +9,12 @@
 
 // Standard Library
 #include <algorithm>
+#include <functional>
 
 // Leggiero.Utility
 #include <Utility/Math/BitMath.h>
 #include <Utility/Sugar/Finally.h>
+#include <Utility/Threading/ThreadAffinity.h>
 #include <Utility/Threading/ThreadSleep.h>
 
 // Leggiero.Engine
@@ -40,8 +42,9 @@ namespace Leggiero
 
 			//------------------------------------------------------------------------------
 			ConcreteTaskManager::ConcreteTaskManager()
-				: m_isRealtimeScheduling(false), m_conditionWaitingQueueProcessing(false)
-				, m_conditionCheckShortTermIndex(-1), m_conditionCheckLongTermIndex(-1)
+				: m_isGameThreadPlaced(false)
+				, m_isRealtimeScheduling(false), m_conditionWaitingQueueProcessing(false), m_parkedTaskProcessing(false)
+				, m_isTimerThreadCreated(false), m_timerNextWakeUp(0), m_timerHeapSize(0), m_timerSweptCancellationEpoch(0)
 				, m_generalTaskCapability(TaskCapabilities::kGeneral)
 			{
 			}
@@ -49,7 +52,9 @@ namespace Leggiero
 			//------------------------------------------------------------------------------
 			ConcreteTaskManager::~ConcreteTaskManager()
 			{
-				_FinalizeSchedulingQueues();
+				TaskCancellationToken::UnRegisterCancellationObserver(this);
+				_FinalizeTimerScheduler();
+				_FinalizeParkedTasks();
 				_FinalizeProcessors();
 
 				TaskExecutionEntry *deletingExecutionEntry;
@@ -65,6 +70,7 @@ namespace Leggiero
 			{
 				m_isRealtimeScheduling.store(false);
 				m_conditionWaitingQueueProcessing.store(false);
+				m_parkedTaskProcessing.store(false);
 
 				for (std::shared_ptr<ITaskSubSystem> &subSystem : m_subSystems)
 				{
@@ -72,7 +78,8 @@ namespace Leggiero
 				}
 
 				_InitializeProcessors();
-				_InitializeSchedulingQueues();
+				_InitializeTimerScheduler();
+				TaskCancellationToken::RegisterCancellationObserver(this);
 
 				m_appComponentCopy->SystemEventCenter().RegisterApplicationEventObserver(this);
 
@@ -86,8 +93,10 @@ namespace Leggiero
 			{
 				m_gameAnchor->UnRegisterOnAfterFrame(this);
 				m_appComponentCopy->SystemEventCenter().UnRegisterApplicationEventObserver(this);
+				TaskCancellationToken::UnRegisterCancellationObserver(this);
 
-				_FinalizeSchedulingQueues();
+				_FinalizeTimerScheduler();
+				_FinalizeParkedTasks();
 				_FinalizeProcessors();
 
 				for (std::shared_ptr<ITaskSubSystem> &subSystem : m_subSystems)
@@ -177,9 +186,36 @@ namespace Leggiero
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::RequestExecution(TaskExecutionEntry *execution)
 			{
+				if (execution->task->IsDropRequested())
+				{
+					_DropExecution(execution);
+					return;
+				}
+
+				if (!execution->task->IsTaskReady())
+				{
+					// Prior tasks will request the execution again when they finished
+					// Once parked, the execution can be touched only by the one who took it from the task.
+					std::shared_ptr<ITask> parkingTask(execution->task);
+					parkingTask->ParkExecution(execution);
+					if (parkingTask->WaitPriorTasksNotified(DependentExecutionLink{ parkingTask }))
+					{
+						// Also polled, for prior tasks finished without notification (e.g. finished outside of task managers)
+						if (parkingTask->MarkParkingPolled())
+						{
+							m_parkedTaskQueue.enqueue(std::move(parkingTask));
+						}
+						return;
+					}
+					if (parkingTask->TakeParkedExecution() != execution)
+					{
+						// Already resumed by a notification
+						return;
+					}
+				}
 				if (!execution->task->IsTaskReady())
 				{
-					// Should wait ready
+					// Should wait ready by polling
 					switch (execution->task->GetTaskPriority())
 					{
 						case TaskPriorityClass::kBackground:
@@ -221,6 +257,11 @@ namespace Leggiero
 				{
 					return;
 				}
+
+				if (execution->task && execution->task->IsFinished())
+				{
+					_ResolveDependentExecutions(*(execution->task));
+				}
 				execution->Clear();
 
 				if (!m_executionEntryPool.enqueue(execution))
@@ -256,6 +297,81 @@ namespace Leggiero
 				return true;
 			}
 
+			//------------------------------------------------------------------------------
+			size_t ConcreteTaskManager::ExecuteTasks(const std::shared_ptr<ITask> *tasks, size_t taskCount)
+			{
+				// Ready executions are grouped by processor to be given at once
+				std::vector<std::pair<ITaskProcessor *, std::vector<TaskExecutionEntry *> > > dispatchingGroups;
+
+				size_t acceptedCount = 0;
+				for (size_t i = 0; i < taskCount; ++i)
+				{
+					const std::shared_ptr<ITask> &currentTask = tasks[i];
+					if (!currentTask)
+					{
+						continue;
+					}
+
+					ITaskProcessor *taskProcessor = _GetTaskProcessor(currentTask->GetRequiredCapabilties());
+					if (taskProcessor == nullptr)
+					{
+						// Cannot process
+						continue;
+					}
+
+					TaskExecutionEntry *execution = _RetainExecution();
+					if (execution == nullptr)
+					{
+						continue;
+					}
+					execution->task = currentTask;
+					++acceptedCount;
+
+					if (!currentTask->IsTaskReady())
+					{
+						// Waiting tasks go through the normal path
+						RequestExecution(execution);
+						continue;
+					}
+
+					std::vector<std::pair<ITaskProcessor *, std::vector<TaskExecutionEntry *> > >::iterator groupIt = std::find_if(dispatchingGroups.begin(), dispatchingGroups.end(),
+						[taskProcessor](const std::pair<ITaskProcessor *, std::vector<TaskExecutionEntry *> > &group) { return (group.first == taskProcessor); });
+					if (groupIt == dispatchingGroups.end())
+					{
+						dispatchingGroups.emplace_back(taskProcessor, std::vector<TaskExecutionEntry *>());
+						dispatchingGroups.back().second.reserve(taskCount - i);
+						groupIt = dispatchingGroups.end() - 1;
+					}
+					groupIt->second.push_back(execution);
+				}
+
+				for (std::pair<ITaskProcessor *, std::vector<TaskExecutionEntry *> > &currentGroup : dispatchingGroups)
+				{
+					currentGroup.first->GiveJobs(currentGroup.second.data(), currentGroup.second.size());
+				}
+				_HintRealtimeSchedule();
+
+				return acceptedCount;
+			}
+
+			//------------------------------------------------------------------------------
+			// Collect current telemetry of the task system
+			void ConcreteTaskManager::GetTelemetrySnapshot(TaskTelemetrySnapshot &outSnapshot)
+			{
+				outSnapshot.processors.resize(m_taskProcessorHolder.size());
+				for (size_t i = 0; i < m_taskProcessorHolder.size(); ++i)
+				{
+					m_taskProcessorHolder[i]->FillTelemetry(outSnapshot.processors[i]);
+				}
+
+				outSnapshot.conditionWaitingRealtimeDepth = m_conditionWaitingQueueRealtime.size_approx();
+				outSnapshot.conditionWaitingShortTermDepth = m_conditionWaitingQueueShortTerm.size_approx();
+				outSnapshot.conditionWaitingLongTermDepth = m_conditionWaitingQueueLongTerm.size_approx();
+				outSnapshot.timerWaitingDepth = m_timerHeapSize.load(std::memory_order_relaxed) + m_timerIncomingQueue.size_approx();
+
+				Telemetry::FillTaskTypeSnapshot(outSnapshot);
+			}
+
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::OnGoToBackground()
 			{
@@ -266,12 +382,19 @@ namespace Leggiero
 			void ConcreteTaskManager::OnReturnFromBackground()
 			{
 				m_schedulerPause.store(false);
-				pthread_cond_broadcast(&m_queuesPauseCond.GetConditionVariable());
+
+				Utility::Threading::ScopedMutexLock lockContext(m_schedulerMutex);
+				pthread_cond_broadcast(&m_schedulerCondition.GetConditionVariable());
 			}
 
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::GameProcess_OnAfterFrame(GameFrameNumberType frameNumber)
 			{
+				if (Utility::Threading::IsThreadPlacementEnabled())
+				{
+					_PlaceGameThread();
+				}
+
 				_HintRealtimeSchedule();
 				_ProcessConditionWaitingQueue(m_conditionWaitingQueueShortTerm);
 
@@ -279,9 +402,38 @@ namespace Leggiero
 				{
 					// Long-term condition check every 8 frames
 					_ProcessConditionWaitingQueue(m_conditionWaitingQueueLongTerm);
+					_ProcessParkedTasks();
+				}
+
+				for (std::shared_ptr<ITaskProcessor> &currentProcessor : m_taskProcessorHolder)
+				{
+					currentProcessor->UpdateProcessor();
 				}
 			}
 
+			//------------------------------------------------------------------------------
+			// Wake the timer thread to sweep cancelled executions at once
+			void ConcreteTaskManager::OnTaskCancelled()
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_schedulerMutex);
+				pthread_cond_signal(&m_schedulerCondition.GetConditionVariable());
+			}
+
+			//------------------------------------------------------------------------------
+			// Pin the thread running game frames; placed again if the platform changed the thread (e.g. GL thread re-creation)
+			void ConcreteTaskManager::_PlaceGameThread()
+			{
+				pthread_t currentThread = pthread_self();
+				if (m_isGameThreadPlaced && pthread_equal(m_placedGameThread, currentThread))
+				{
+					return;
+				}
+
+				Utility::Threading::PlaceCurrentThread(Utility::Threading::ThreadPlacementRole::kGame);
+				m_placedGameThread = currentThread;
+				m_isGameThreadPlaced = true;
+			}
+
 			//------------------------------------------------------------------------------
 			TaskExecutionEntry *ConcreteTaskManager::_RetainExecution()
 			{
@@ -294,6 +446,41 @@ namespace Leggiero
 				return new TaskExecutionEntry();
 			}
 
+			//------------------------------------------------------------------------------
+			// Request executions of dependent tasks which became ready by the finished task
+			void ConcreteTaskManager::_ResolveDependentExecutions(ITask &finishedTask)
+			{
+				std::vector<DependentExecutionLink> dependentExecutions;
+				finishedTask.TakeDependentExecutions(dependentExecutions);
+
+				// The execution can be touched only by the one taking it from the task
+				for (DependentExecutionLink &currentLink : dependentExecutions)
+				{
+					std::shared_ptr<ITask> dependentTask(currentLink.task.lock());
+					if (!dependentTask)
+					{
+						// Already released
+						continue;
+					}
+					if (dependentTask->NotifyPriorTaskFinished())
+					{
+						TaskExecutionEntry *resumingExecution = dependentTask->TakeParkedExecution();
+						if (resumingExecution != nullptr)
+						{
+							RequestExecution(resumingExecution);
+						}
+					}
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			// Finish the execution as cancelled without running
+			void ConcreteTaskManager::_DropExecution(TaskExecutionEntry *execution)
+			{
+				execution->task->MarkDropped();
+				ReleaseExecution(execution);
+			}
+
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::_DispatchExecution(TaskExecutionEntry *execution)
 			{
@@ -414,46 +601,11 @@ namespace Leggiero
 				bool notScheduling = false;
 				if (m_isRealtimeScheduling.compare_exchange_strong(notScheduling, true))
 				{
-					_RealtimeSchedule();
 					_ProcessConditionWaitingQueue(m_conditionWaitingQueueRealtime);
 					m_isRealtimeScheduling.store(false);
 				}
 			}
 
-			//------------------------------------------------------------------------------
-			void ConcreteTaskManager::_RealtimeSchedule()
-			{
-				TaskExecutionEntry *dequeuedExecution;
-				size_t executionBatchCount = 0;
-				while (m_realtimeWaitingQueue.try_dequeue(dequeuedExecution))
-				{
-					m_realtimeSchedulingBuffer[executionBatchCount] = dequeuedExecution;
-					++executionBatchCount;
-					if (executionBatchCount >= kRealtimeScheduleMaxBatchCount)
-					{
-						break;
-					}
-				}
-
-				for (size_t i = 0; i < executionBatchCount; ++i)
-				{
-					TaskExecutionEntry *currentExecution = m_realtimeSchedulingBuffer[i];
-					if (currentExecution->lastStep <= SchedulingClock::now())
-					{
-						RequestExecution(currentExecution);
-						m_realtimeSchedulingBuffer[i] = nullptr;
-					}
-				}
-
-				for (size_t i = 0; i < executionBatchCount; ++i)
-				{
-					if (m_realtimeSchedulingBuffer[i] != nullptr)
-					{
-						m_realtimeWaitingQueue.enqueue(m_realtimeSchedulingBuffer[i]);
-					}
-				}
-			}
-
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::_ProcessConditionWaitingQueue(moodycamel::ConcurrentQueue<TaskExecutionEntry *> &queue)
 			{
@@ -479,7 +631,11 @@ namespace Leggiero
 
 					for (TaskExecutionEntry *currentExecution : m_conditionWaitingProcessBuffer)
 					{
-						if (currentExecution->task->IsTaskReady())
+						if (currentExecution->task->IsDropRequested())
+						{
+							_DropExecution(currentExecution);
+						}
+						else if (currentExecution->task->IsTaskReady())
 						{
 							_DispatchExecution(currentExecution);
 						}
@@ -493,201 +649,296 @@ namespace Leggiero
 			}
 
 			//------------------------------------------------------------------------------
-			void ConcreteTaskManager::_InitializeSchedulingQueues()
+			// Poll parked tasks, to resume ones whose priors finished without notification and to drop cancelled ones
+			void ConcreteTaskManager::_ProcessParkedTasks()
 			{
-				// Queue Definitions
-				static std::vector<SchedulingClock::duration> queueWaitingTimes{
-					std::chrono::milliseconds(2), 
-					std::chrono::milliseconds(8),
-					std::chrono::milliseconds(32),
-					std::chrono::milliseconds(128),
-					std::chrono::milliseconds(1024),
-				};
-				std::sort(queueWaitingTimes.begin(), queueWaitingTimes.end());
+				bool notProcessing = false;
+				if (!m_parkedTaskProcessing.compare_exchange_strong(notProcessing, true))
+				{
+					return;
+				}
+				std::atomic_bool *lockCopy = &m_parkedTaskProcessing;
+				auto releaseLockFunc = [lockCopy]() mutable { lockCopy->store(false); };
+				FINALLY_OF_BLOCK(_RELEASE_LOCK, releaseLockFunc);
 
-				m_schedulerRunning.store(true);
-				m_schedulerPause.store(false);
+				std::shared_ptr<ITask> dequeuedTask;
+				while (m_parkedTaskQueue.try_dequeue(dequeuedTask))
+				{
+					m_parkedTaskProcessBuffer.push_back(std::move(dequeuedTask));
+				}
 
-				m_schedulingQueues.reserve(queueWaitingTimes.size());
-				for (int i = 0; i < queueWaitingTimes.size(); ++i)
+				for (std::shared_ptr<ITask> &currentTask : m_parkedTaskProcessBuffer)
 				{
-					SchedulingQueueEntry *currentQueueEntry = new SchedulingQueueEntry();
-					currentQueueEntry->minimumWaiting = queueWaitingTimes[i];
-					currentQueueEntry->owner = this;
-					currentQueueEntry->queueIndex = i;
-					m_schedulingQueues.push_back(currentQueueEntry);
+					// Unmark first, so that the task parked again from now is queued again by the parking side
+					currentTask->ClearParkingPolled();
+
+					if (currentTask->IsDropRequested() || currentTask->IsTaskReady())
+					{
+						TaskExecutionEntry *resumingExecution = currentTask->TakeParkedExecution();
+						if (resumingExecution != nullptr)
+						{
+							RequestExecution(resumingExecution);
+						}
+					}
+					else if (currentTask->HasParkedExecution() && currentTask->MarkParkingPolled())
+					{
+						m_parkedTaskQueue.enqueue(currentTask);
+					}
 				}
+				m_parkedTaskProcessBuffer.clear();
+			}
 
-				for (SchedulingQueueEntry *currentQueueEntry : m_schedulingQueues)
+			//------------------------------------------------------------------------------
+			// Cancel left parked executions; also breaks the references kept by parked tasks
+			void ConcreteTaskManager::_FinalizeParkedTasks()
+			{
+				std::shared_ptr<ITask> dequeuedTask;
+				while (m_parkedTaskQueue.try_dequeue(dequeuedTask))
 				{
-					if (pthread_create(&currentQueueEntry->schedulingThread, NULL, ConcreteTaskManager::_SchedulingQueueThreadStartHelper, (void *)currentQueueEntry) != 0)
+					dequeuedTask->ClearParkingPolled();
+
+					TaskExecutionEntry *leftExecution = dequeuedTask->TakeParkedExecution();
+					if (leftExecution == nullptr)
+					{
+						continue;
+					}
+					if (!dequeuedTask->IsFinished())
 					{
-						// Thread Creation Failed
+						dequeuedTask->SetErrorFlag();
+						dequeuedTask->State().store(TaskState::kError);
 					}
+					ReleaseExecution(leftExecution);
 				}
+			}
+
+			//------------------------------------------------------------------------------
+			void ConcreteTaskManager::_InitializeTimerScheduler()
+			{
+				m_schedulerRunning.store(true);
+				m_schedulerPause.store(false);
 
-				m_schedulingQueuesCount = static_cast<int>(m_schedulingQueues.size());
+				SchedulingClock::time_point now = SchedulingClock::now();
+				m_nextShortTermConditionCheck = now + kShortTermConditionCheckInterval;
+				m_nextLongTermConditionCheck = now + kLongTermConditionCheckInterval;
+				m_timerNextWakeUp.store(now.time_since_epoch().count());
 
-				m_conditionCheckShortTermIndex = 1;
-				m_conditionCheckLongTermIndex = 3;
+				if (pthread_create(&m_timerThread, NULL, ConcreteTaskManager::_TimerThreadStartHelper, (void *)this) != 0)
+				{
+					// Thread Creation Failed
+					m_isTimerThreadCreated = false;
+					return;
+				}
+				m_isTimerThreadCreated = true;
 			}
 
 			//------------------------------------------------------------------------------
-			void ConcreteTaskManager::_FinalizeSchedulingQueues()
+			void ConcreteTaskManager::_FinalizeTimerScheduler()
 			{
 				m_schedulerPause.store(false);
 				m_schedulerRunning.store(false);
 
-				pthread_cond_broadcast(&m_queuesPauseCond.GetConditionVariable());
+				{
+					Utility::Threading::ScopedMutexLock lockContext(m_schedulerMutex);
+					pthread_cond_broadcast(&m_schedulerCondition.GetConditionVariable());
+				}
 
-				if (m_schedulingQueues.empty())
+				if (!m_isTimerThreadCreated)
 				{
 					return;
 				}
+				pthread_join(m_timerThread, NULL);
+				m_isTimerThreadCreated = false;
 
-				for (SchedulingQueueEntry *currentQueueEntry : m_schedulingQueues)
+				// Cancel left sleeping executions
+				TaskExecutionEntry *dequeuedExecution;
+				while (m_timerIncomingQueue.try_dequeue(dequeuedExecution))
 				{
-					pthread_join(currentQueueEntry->schedulingThread, NULL);
-					delete currentQueueEntry;
+					m_timerHeap.push_back(TimerEntry{ dequeuedExecution->lastStep, dequeuedExecution });
 				}
-				m_schedulingQueues.clear();
+				for (TimerEntry &currentEntry : m_timerHeap)
+				{
+					if (currentEntry.execution->task)
+					{
+						ITask &task = *(currentEntry.execution->task);
+						if (!task.IsFinished())
+						{
+							task.SetErrorFlag();
+							task.State().store(TaskState::kError);
+						}
+					}
+					ReleaseExecution(currentEntry.execution);
+				}
+				m_timerHeap.clear();
 			}
 
 			//------------------------------------------------------------------------------
-			void ConcreteTaskManager::_SchedulingQueueThreadFunction(ConcreteTaskManager::SchedulingQueueEntry &queueEntry)
+			void ConcreteTaskManager::_TimerThreadFunction()
 			{
-				std::chrono::duration<int, std::micro> microsecMinimumWaiting(std::chrono::duration_cast<std::chrono::duration<int, std::micro> >(queueEntry.minimumWaiting));
-				int waitingMicroseconds = microsecMinimumWaiting.count() / 2;
-				if (waitingMicroseconds <= 0)
-				{
-					waitingMicroseconds = 1;
-				}
-				
-				std::chrono::nanoseconds startNs;
-				std::chrono::nanoseconds finishNs;
 				while (m_schedulerRunning.load())
 				{
-					startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
-
 					// Process Pause
 					if (m_schedulerPause.load())
 					{
-						int pauseCondLockResult = pthread_mutex_lock(&(m_queuesPauseMutex.GetLock()));
-						if (pauseCondLockResult == 0)
+						Utility::Threading::ScopedMutexLock pauseCondLockContext(m_schedulerMutex);
+						if (pauseCondLockContext)
 						{
-							pthread_mutex_t *lockCopy = &(m_queuesPauseMutex.GetLock());
-							auto releaseLockFunc = [lockCopy]() mutable { pthread_mutex_unlock(lockCopy); };
-							FINALLY_OF_BLOCK(_RELEASE_LOCK, releaseLockFunc);
-
-							if (m_schedulerPause.load())
+							if (m_schedulerPause.load() && m_schedulerRunning.load())
 							{
-								pthread_cond_wait(&(m_queuesPauseCond.GetConditionVariable()), &(m_queuesPauseMutex.GetLock()));
+								pthread_cond_wait(&(m_schedulerCondition.GetConditionVariable()), &(m_schedulerMutex.GetLock()));
 							}
 						}
-
-						// Yield and re-check
-						sched_yield();
+						else
+						{
+							Utility::Threading::PthreadSleepMS(1);
+						}
 						continue;
 					}
 
-					_DoWaitingQueueScheduling(queueEntry.queueIndex, queueEntry);
-
-					if (queueEntry.queueIndex == m_conditionCheckShortTermIndex)
-					{
-						_ProcessConditionWaitingQueue(m_conditionWaitingQueueShortTerm);
-					}
-					else if (queueEntry.queueIndex == m_conditionCheckLongTermIndex)
-					{
-						_ProcessConditionWaitingQueue(m_conditionWaitingQueueLongTerm);
-					}
-
-					_HintRealtimeSchedule();
+					SchedulingClock::time_point nextWakeUp = _DoTimerScheduling();
 
-					finishNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch());
-					
-					auto elapsedNs = (finishNs - startNs).count();
-					if (elapsedNs < 0)
-					{
-						elapsedNs = 0;
-					}
-					int shouldWaiting = waitingMicroseconds - static_cast<int>(elapsedNs / 1000);
+					// Publish next wake-up before re-checking the incoming queue, so that an enqueuer either sees it or its entry is seen here
+					//note: moodycamel queue size is approximate. for worst cases, an earlier entry can wait until the next wake-up (at most kTimerMaxWaiting)
+					m_timerNextWakeUp.store(nextWakeUp.time_since_epoch().count());
+					std::atomic_thread_fence(std::memory_order_seq_cst);
 
-					if (shouldWaiting > 0)
+					Utility::Threading::ScopedMutexLock timerLockContext(m_schedulerMutex);
+					if (timerLockContext)
 					{
-						Utility::Threading::PthreadSleepuS(shouldWaiting);
+						// Cancellation epoch is checked in the lock, not to miss the wake-up signal of a cancellation
+						if (m_schedulerRunning.load() && !m_schedulerPause.load() && m_timerIncomingQueue.size_approx() == 0
+							&& TaskCancellationToken::GetCancellationEpoch() == m_timerSweptCancellationEpoch)
+						{
+							timespec waitLimit = Utility::Threading::ToSystemTimespec(nextWakeUp);
+							pthread_cond_timedwait(&(m_schedulerCondition.GetConditionVariable()), &(m_schedulerMutex.GetLock()), &waitLimit);
+						}
 					}
 					else
 					{
-						sched_yield();
+						// If lock fails, just wait 1ms and go
+						Utility::Threading::PthreadSleepMS(1);
 					}
 				}
 			}
 
 			//------------------------------------------------------------------------------
-			void ConcreteTaskManager::_DoWaitingQueueScheduling(int queueIndex, ConcreteTaskManager::SchedulingQueueEntry &queueEntry)
+			// Fire due executions and return the time to wake up next
+			SchedulingClock::time_point ConcreteTaskManager::_DoTimerScheduling()
 			{
 				TaskExecutionEntry *dequeuedExecution;
-				while (queueEntry.queue.try_dequeue(dequeuedExecution))
+				while (m_timerIncomingQueue.try_dequeue(dequeuedExecution))
+				{
+					m_timerHeap.push_back(TimerEntry{ dequeuedExecution->lastStep, dequeuedExecution });
+					std::push_heap(m_timerHeap.begin(), m_timerHeap.end(), std::greater<TimerEntry>());
+				}
+
+				// Sleeping executions of cancelled tasks leave at once, not at their wake-up
+				uint64_t cancellationEpoch = TaskCancellationToken::GetCancellationEpoch();
+				if (cancellationEpoch != m_timerSweptCancellationEpoch)
 				{
-					queueEntry.queueProcessingBuffer.push_back(dequeuedExecution);
+					m_timerSweptCancellationEpoch = cancellationEpoch;
+					_SweepCancelledTimerEntries();
+					_ProcessParkedTasks();
 				}
 
-				for (TaskExecutionEntry *currentExecution : queueEntry.queueProcessingBuffer)
+				// Collect due executions first to fire them in a batch
+				SchedulingClock::time_point now = SchedulingClock::now();
+				while (!m_timerHeap.empty() && m_timerHeap.front().wakeTime <= now)
 				{
-					if (currentExecution->lastStep <= SchedulingClock::now())
+					m_timerFiringBuffer.push_back(m_timerHeap.front().execution);
+					std::pop_heap(m_timerHeap.begin(), m_timerHeap.end(), std::greater<TimerEntry>());
+					m_timerHeap.pop_back();
+				}
+
+				for (TaskExecutionEntry *currentExecution : m_timerFiringBuffer)
+				{
+					RequestExecution(currentExecution);
+				}
+				m_timerFiringBuffer.clear();
+
+				// Periodic condition checks
+				now = SchedulingClock::now();
+				if (now >= m_nextShortTermConditionCheck)
+				{
+					_ProcessConditionWaitingQueue(m_conditionWaitingQueueShortTerm);
+					m_nextShortTermConditionCheck = now + kShortTermConditionCheckInterval;
+				}
+				if (now >= m_nextLongTermConditionCheck)
+				{
+					_ProcessConditionWaitingQueue(m_conditionWaitingQueueLongTerm);
+					_ProcessParkedTasks();
+					m_nextLongTermConditionCheck = now + kLongTermConditionCheckInterval;
+				}
+				_HintRealtimeSchedule();
+
+				m_timerHeapSize.store(m_timerHeap.size(), std::memory_order_relaxed);
+
+				// Calculate next wake-up
+				SchedulingClock::time_point nextWakeUp = now + kTimerMaxWaiting;
+				if (!m_timerHeap.empty() && m_timerHeap.front().wakeTime < nextWakeUp)
+				{
+					nextWakeUp = m_timerHeap.front().wakeTime;
+				}
+				if (m_conditionWaitingQueueRealtime.size_approx() > 0)
+				{
+					nextWakeUp = std::min(nextWakeUp, now + std::chrono::duration_cast<SchedulingClock::duration>(kRealtimeConditionCheckInterval));
+				}
+				if (m_conditionWaitingQueueShortTerm.size_approx() > 0)
+				{
+					nextWakeUp = std::min(nextWakeUp, m_nextShortTermConditionCheck);
+				}
+				if (m_conditionWaitingQueueLongTerm.size_approx() > 0 || m_parkedTaskQueue.size_approx() > 0)
+				{
+					nextWakeUp = std::min(nextWakeUp, m_nextLongTermConditionCheck);
+				}
+
+				return nextWakeUp;
+			}
+
+			//------------------------------------------------------------------------------
+			void ConcreteTaskManager::_SweepCancelledTimerEntries()
+			{
+				std::vector<TimerEntry>::iterator keepIt = m_timerHeap.begin();
+				for (TimerEntry &currentEntry : m_timerHeap)
+				{
+					TaskCancellationToken *token = currentEntry.execution->task->GetCancellationToken().get();
+					if (token != nullptr && token->IsCancelled())
 					{
-						queueEntry.queueProcessingNowBuffer.push_back(currentExecution);
+						_DropExecution(currentEntry.execution);
 					}
 					else
 					{
-						// Re-dispatch to waiting queue
-						_EnqueueWaitingExecution(currentExecution);
+						*keepIt = currentEntry;
+						++keepIt;
 					}
 				}
-				queueEntry.queueProcessingBuffer.clear();
 
-				for (TaskExecutionEntry *currentExecution : queueEntry.queueProcessingNowBuffer)
+				if (keepIt != m_timerHeap.end())
 				{
-					RequestExecution(currentExecution);
+					m_timerHeap.erase(keepIt, m_timerHeap.end());
+					std::make_heap(m_timerHeap.begin(), m_timerHeap.end(), std::greater<TimerEntry>());
 				}
-				queueEntry.queueProcessingNowBuffer.clear();
 			}
 
 			//------------------------------------------------------------------------------
-			void *ConcreteTaskManager::_SchedulingQueueThreadStartHelper(void *threadEntry)
+			void *ConcreteTaskManager::_TimerThreadStartHelper(void *threadThis)
 			{
-				SchedulingQueueEntry *queueEntry = (SchedulingQueueEntry *)threadEntry;
-				queueEntry->owner->_SchedulingQueueThreadFunction(*queueEntry);
+				Utility::Threading::PlaceCurrentThread(Utility::Threading::ThreadPlacementRole::kTaskScheduler);
+				((ConcreteTaskManager *)threadThis)->_TimerThreadFunction();
 				return nullptr;
 			}
 
 			//------------------------------------------------------------------------------
 			void ConcreteTaskManager::_EnqueueWaitingExecution(TaskExecutionEntry *execution)
 			{
-				SchedulingClock::duration waitingTime = execution->lastStep - SchedulingClock::now();
-				
-				if (m_schedulingQueues.empty() || (waitingTime <= m_schedulingQueues.front()->minimumWaiting))
-				{
-					// Realtime scheduling
-					m_realtimeWaitingQueue.enqueue(execution);
-					return;
-				}
+				m_timerIncomingQueue.enqueue(execution);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
 
-				// Linear search because queues are not too many
-				int targetQueueIndex = 0;
-				for (int i = 1; i < m_schedulingQueuesCount; ++i)
+				// Wake the timer only when the execution should be fired before the timer's planned wake-up
+				if (execution->lastStep.time_since_epoch().count() < m_timerNextWakeUp.load())
 				{
-					if (waitingTime > m_schedulingQueues[i]->minimumWaiting)
-					{
-						targetQueueIndex = i;
-					}
-					else
-					{
-						break;
-					}
+					Utility::Threading::ScopedMutexLock lockContext(m_schedulerMutex);
+					pthread_cond_signal(&(m_schedulerCondition.GetConditionVariable()));
 				}
-
-				m_schedulingQueues[targetQueueIndex]->queue.enqueue(execution);
 			}
 		}
 
@@ -0,0 +1,596 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// DeterministicTaskManager.cpp (Leggiero/Modules - Task)
+//
+// Deterministic Task Manager Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "DeterministicTaskManager.h"
+
+// Standard Library
+#include <algorithm>
+#include <functional>
+
+// Leggiero.Engine
+#include <Engine/Application/GameProcessAnchor.h>
+
+// Leggiero.Task
+#include "_Internal/_TaskExecutionEntry.h"
+#include "Tasks/ITask.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+		namespace _Internal
+		{
+			// Deadline checks on current thread see the virtual time in the scope
+			class ScopedSchedulingTimeOverride
+			{
+			public:
+				ScopedSchedulingTimeOverride(SchedulingClock::time_point schedulingTime)
+					: m_schedulingTime(schedulingTime), m_previousOverride(t_schedulingTimeOverride)
+				{
+					t_schedulingTimeOverride = &m_schedulingTime;
+				}
+
+				~ScopedSchedulingTimeOverride()
+				{
+					t_schedulingTimeOverride = m_previousOverride;
+				}
+
+			private:
+				SchedulingClock::time_point			m_schedulingTime;
+				const SchedulingClock::time_point	*m_previousOverride;
+			};
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// DeterministicTaskManager
+
+		//------------------------------------------------------------------------------
+		DeterministicTaskManager::DeterministicTaskManager(SchedulingClock::duration frameTimeStep)
+			: m_gameAnchor(nullptr), m_frameTimeStep(frameTimeStep)
+			, m_virtualNow(), m_sleepingSequence(0), m_sweptCancellationEpoch(TaskCancellationToken::GetCancellationEpoch())
+		{
+		}
+
+		//------------------------------------------------------------------------------
+		DeterministicTaskManager::~DeterministicTaskManager()
+		{
+			for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+			{
+				for (TaskExecutionEntry *currentExecution : m_readyQueues[lane])
+				{
+					_CancelExecution(currentExecution);
+				}
+				m_readyQueues[lane].clear();
+			}
+			for (TaskExecutionEntry *currentExecution : m_passQueue)
+			{
+				_CancelExecution(currentExecution);
+			}
+			m_passQueue.clear();
+			for (TaskExecutionEntry *currentExecution : m_conditionWaitingList)
+			{
+				_CancelExecution(currentExecution);
+			}
+			m_conditionWaitingList.clear();
+			for (SleepingEntry &currentEntry : m_sleepingHeap)
+			{
+				_CancelExecution(currentEntry.execution);
+			}
+			m_sleepingHeap.clear();
+		}
+
+		//------------------------------------------------------------------------------
+		// Initialize the Component
+		void DeterministicTaskManager::InitializeComponent(Engine::GameProcessAnchor *gameAnchor)
+		{
+			m_gameAnchor = gameAnchor;
+			if (m_gameAnchor != nullptr && m_frameTimeStep > SchedulingClock::duration::zero())
+			{
+				m_gameAnchor->RegisterOnAfterFrame(this);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		// Safely Shutdown Component
+		void DeterministicTaskManager::ShutdownComponent()
+		{
+			if (m_gameAnchor != nullptr && m_frameTimeStep > SchedulingClock::duration::zero())
+			{
+				m_gameAnchor->UnRegisterOnAfterFrame(this);
+			}
+			m_gameAnchor = nullptr;
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::RequestExecution(TaskExecutionEntry *execution)
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+			_Internal::ScopedSchedulingTimeOverride timeContext(m_virtualNow);
+
+			if (execution->task->IsTaskReady())
+			{
+				_PushReady(execution);
+			}
+			else
+			{
+				m_conditionWaitingList.push_back(execution);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::RequestDelayedExecution(TaskExecutionEntry *execution, SchedulingClock::duration delay)
+		{
+			if (delay <= SchedulingClock::duration::zero())
+			{
+				// No Delay
+				RequestExecution(execution);
+				return;
+			}
+
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+			m_sleepingHeap.push_back(SleepingEntry{ m_virtualNow + delay, m_sleepingSequence++, execution });
+			std::push_heap(m_sleepingHeap.begin(), m_sleepingHeap.end(), std::greater<SleepingEntry>());
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::ReleaseExecution(TaskExecutionEntry *execution)
+		{
+			if (execution == nullptr)
+			{
+				return;
+			}
+
+			execution->Clear();
+			delete execution;
+		}
+
+		//------------------------------------------------------------------------------
+		bool DeterministicTaskManager::ExecuteTask(std::shared_ptr<ITask> task)
+		{
+			if (!task)
+			{
+				return false;
+			}
+
+			TaskExecutionEntry *execution = new TaskExecutionEntry();
+			execution->task = task;
+			RequestExecution(execution);
+
+			return true;
+		}
+
+		//------------------------------------------------------------------------------
+		size_t DeterministicTaskManager::ExecuteTasks(const std::shared_ptr<ITask> *tasks, size_t taskCount)
+		{
+			size_t acceptedCount = 0;
+			for (size_t i = 0; i < taskCount; ++i)
+			{
+				if (ExecuteTask(tasks[i]))
+				{
+					++acceptedCount;
+				}
+			}
+			return acceptedCount;
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::GetTelemetrySnapshot(TaskTelemetrySnapshot &outSnapshot)
+		{
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+				size_t readyCount = m_passQueue.size();
+				for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+				{
+					readyCount += m_readyQueues[lane].size();
+				}
+
+				outSnapshot.processors.resize(1);
+				outSnapshot.processors[0].capability = TaskCapabilities::kGeneral;
+				outSnapshot.processors[0].queueDepth = readyCount;
+				outSnapshot.processors[0].workers.clear();
+
+				outSnapshot.conditionWaitingRealtimeDepth = 0;
+				outSnapshot.conditionWaitingShortTermDepth = m_conditionWaitingList.size();
+				outSnapshot.conditionWaitingLongTermDepth = 0;
+				outSnapshot.timerWaitingDepth = m_sleepingHeap.size();
+			}
+
+			Telemetry::FillTaskTypeSnapshot(outSnapshot);
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::GameProcess_OnAfterFrame(GameFrameNumberType /*frameNumber*/)
+		{
+			AdvanceVirtualTime(m_frameTimeStep);
+
+			// Only one pass in a frame, not to be hung by a task yielding forever
+			RunReadySteps();
+		}
+
+		//------------------------------------------------------------------------------
+		SchedulingClock::time_point DeterministicTaskManager::GetVirtualTime()
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+			return m_virtualNow;
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::AdvanceVirtualTime(SchedulingClock::duration duration)
+		{
+			if (duration <= SchedulingClock::duration::zero())
+			{
+				return;
+			}
+
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+			m_virtualNow += duration;
+		}
+
+		//------------------------------------------------------------------------------
+		// Jump the virtual clock to the earliest sleeping task; returns false if nothing is sleeping
+		bool DeterministicTaskManager::AdvanceToNextWakeUp()
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+			if (m_sleepingHeap.empty())
+			{
+				return false;
+			}
+			if (m_sleepingHeap.front().wakeTime > m_virtualNow)
+			{
+				m_virtualNow = m_sleepingHeap.front().wakeTime;
+			}
+			return true;
+		}
+
+		//------------------------------------------------------------------------------
+		// Set the deadline of a task to the timeout from the current virtual time
+		void DeterministicTaskManager::SetVirtualDeadline(ITask &task, SchedulingClock::duration timeout)
+		{
+			task.SetDeadline(GetVirtualTime() + timeout);
+		}
+
+		//------------------------------------------------------------------------------
+		// Process one step of every task ready at the start of the pass, in priority then submission order
+		size_t DeterministicTaskManager::RunReadySteps(size_t maxSteps)
+		{
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+				// Tasks re-queued or newly executed during this pass wait in the ready lanes for the next pass
+				_PromoteWaitingExecutions();
+				for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+				{
+					m_passQueue.insert(m_passQueue.end(), m_readyQueues[lane].begin(), m_readyQueues[lane].end());
+					m_readyQueues[lane].clear();
+				}
+			}
+
+			size_t processedCount = 0;
+			while (processedCount < maxSteps)
+			{
+				TaskExecutionEntry *execution = _PopPassEntry();
+				if (execution == nullptr)
+				{
+					break;
+				}
+
+				_ProcessStep(execution);
+				++processedCount;
+			}
+
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+				// Left by the step limit; keep their turn ahead of the tasks queued during the pass
+				while (!m_passQueue.empty())
+				{
+					TaskExecutionEntry *execution = m_passQueue.back();
+					m_passQueue.pop_back();
+					m_readyQueues[_GetPriorityLane(execution)].push_front(execution);
+				}
+			}
+
+			return processedCount;
+		}
+
+		//------------------------------------------------------------------------------
+		// Repeat passes without advancing the virtual clock until no task is ready
+		size_t DeterministicTaskManager::RunUntilIdle(size_t maxSteps)
+		{
+			size_t totalStepCount = 0;
+			while (totalStepCount < maxSteps)
+			{
+				size_t passStepCount = RunReadySteps(maxSteps - totalStepCount);
+				if (passStepCount == 0)
+				{
+					break;
+				}
+				totalStepCount += passStepCount;
+			}
+			return totalStepCount;
+		}
+
+		//------------------------------------------------------------------------------
+		// Advance the virtual clock by the tick and run until idle, repeatedly for the duration
+		size_t DeterministicTaskManager::RunFor(SchedulingClock::duration duration, SchedulingClock::duration tick, size_t maxSteps)
+		{
+			if (tick <= SchedulingClock::duration::zero())
+			{
+				tick = duration;
+			}
+
+			size_t totalStepCount = RunUntilIdle(maxSteps);
+			SchedulingClock::duration leftDuration = duration;
+			while (leftDuration > SchedulingClock::duration::zero() && totalStepCount < maxSteps)
+			{
+				SchedulingClock::duration currentTick = std::min(tick, leftDuration);
+				AdvanceVirtualTime(currentTick);
+				leftDuration -= currentTick;
+
+				totalStepCount += RunUntilIdle(maxSteps - totalStepCount);
+			}
+
+			return totalStepCount;
+		}
+
+		//------------------------------------------------------------------------------
+		size_t DeterministicTaskManager::GetPendingTaskCount()
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+			size_t pendingCount = m_passQueue.size() + m_conditionWaitingList.size() + m_sleepingHeap.size();
+			for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+			{
+				pendingCount += m_readyQueues[lane].size();
+			}
+			return pendingCount;
+		}
+
+		//------------------------------------------------------------------------------
+		int DeterministicTaskManager::_GetPriorityLane(TaskExecutionEntry *execution)
+		{
+			switch (execution->task->GetTaskPriority())
+			{
+				case TaskPriorityClass::kHighPriority:
+					return 0;
+
+				case TaskPriorityClass::kBackground:
+					return 2;
+
+				default:
+					break;
+			}
+			return 1;
+		}
+
+		//------------------------------------------------------------------------------
+		// Should be called in the queue lock
+		void DeterministicTaskManager::_PushReady(TaskExecutionEntry *execution)
+		{
+			m_readyQueues[_GetPriorityLane(execution)].push_back(execution);
+		}
+
+		//------------------------------------------------------------------------------
+		TaskExecutionEntry *DeterministicTaskManager::_PopPassEntry()
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+
+			if (m_passQueue.empty())
+			{
+				return nullptr;
+			}
+			TaskExecutionEntry *execution = m_passQueue.front();
+			m_passQueue.pop_front();
+			return execution;
+		}
+
+		//------------------------------------------------------------------------------
+		// Should be called in the queue lock
+		void DeterministicTaskManager::_PromoteWaitingExecutions()
+		{
+			_Internal::ScopedSchedulingTimeOverride timeContext(m_virtualNow);
+
+			// Sleeping executions of cancelled tasks leave at once, not at their wake-up
+			uint64_t cancellationEpoch = TaskCancellationToken::GetCancellationEpoch();
+			if (cancellationEpoch != m_sweptCancellationEpoch)
+			{
+				m_sweptCancellationEpoch = cancellationEpoch;
+				_SweepCancelledSleepingExecutions();
+			}
+
+			// Due sleeps in order of wake time, then of sleep request
+			while (!m_sleepingHeap.empty() && m_sleepingHeap.front().wakeTime <= m_virtualNow)
+			{
+				TaskExecutionEntry *execution = m_sleepingHeap.front().execution;
+				std::pop_heap(m_sleepingHeap.begin(), m_sleepingHeap.end(), std::greater<SleepingEntry>());
+				m_sleepingHeap.pop_back();
+
+				if (execution->task->IsTaskReady())
+				{
+					_PushReady(execution);
+				}
+				else
+				{
+					m_conditionWaitingList.push_back(execution);
+				}
+			}
+
+			// Ready conditions in order of waiting
+			std::vector<TaskExecutionEntry *>::iterator keepIt = m_conditionWaitingList.begin();
+			for (TaskExecutionEntry *execution : m_conditionWaitingList)
+			{
+				if (execution->task->IsDropRequested(m_virtualNow) || execution->task->IsTaskReady())
+				{
+					_PushReady(execution);
+				}
+				else
+				{
+					*keepIt = execution;
+					++keepIt;
+				}
+			}
+			m_conditionWaitingList.erase(keepIt, m_conditionWaitingList.end());
+		}
+
+		//------------------------------------------------------------------------------
+		// Should be called in the queue lock
+		void DeterministicTaskManager::_SweepCancelledSleepingExecutions()
+		{
+			std::vector<SleepingEntry> cancelledEntries;
+			std::vector<SleepingEntry>::iterator keepIt = m_sleepingHeap.begin();
+			for (SleepingEntry &currentEntry : m_sleepingHeap)
+			{
+				TaskCancellationToken *token = currentEntry.execution->task->GetCancellationToken().get();
+				if (token != nullptr && token->IsCancelled())
+				{
+					cancelledEntries.push_back(currentEntry);
+				}
+				else
+				{
+					*keepIt = currentEntry;
+					++keepIt;
+				}
+			}
+			if (cancelledEntries.empty())
+			{
+				return;
+			}
+			m_sleepingHeap.erase(keepIt, m_sleepingHeap.end());
+			std::make_heap(m_sleepingHeap.begin(), m_sleepingHeap.end(), std::greater<SleepingEntry>());
+
+			// Dropped by the step processing, in the same order as they would wake up
+			std::sort(cancelledEntries.begin(), cancelledEntries.end(), [](const SleepingEntry &lhs, const SleepingEntry &rhs) { return (rhs > lhs); });
+			for (SleepingEntry &currentEntry : cancelledEntries)
+			{
+				_PushReady(currentEntry.execution);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		// Same step processing with the thread worker, but inline
+		void DeterministicTaskManager::_ProcessStep(TaskExecutionEntry *execution)
+		{
+			ITask *pTask = execution->task.get();
+			if (pTask == nullptr || pTask->IsFinished())
+			{
+				ReleaseExecution(execution);
+				return;
+			}
+			// Deadlines and the conditions checked by the task are also on the virtual clock
+			_Internal::ScopedSchedulingTimeOverride timeContext(GetVirtualTime());
+			if (pTask->IsDropRequested(GetSchedulingTime()))
+			{
+				pTask->MarkDropped();
+				ReleaseExecution(execution);
+				return;
+			}
+			if (pTask->HasError())
+			{
+				pTask->State().store(TaskState::kError);
+				ReleaseExecution(execution);
+				return;
+			}
+
+			// Before Start Process
+			if (!Utility::SyntacticSugar::HasFlag(pTask->GetTaskState(), TaskState::kJobStarted))
+			{
+				pTask->OnBeforeProcess();
+				pTask->State().store(pTask->GetTaskState() | TaskState::kJobStarted);
+			}
+			if (pTask->HasError())
+			{
+				pTask->State().store(TaskState::kError);
+				ReleaseExecution(execution);
+				return;
+			}
+
+			// Do Main Task
+			pTask->State().store(pTask->GetTaskState() | TaskState::kJobProcessing);
+
+			#if _LEGGIERO_TASK_TELEMETRY
+				bool isTelemetryEnabled = Telemetry::IsEnabled();
+				TelemetryClock::time_point stepStartTime;
+				if (isTelemetryEnabled)
+				{
+					stepStartTime = TelemetryClock::now();
+				}
+			#endif
+
+			pTask->OnBeforeStepProcess();
+			TaskDoneResult taskResult = pTask->Do();
+			execution->lastStep = GetVirtualTime();
+			pTask->OnAfterStepProcess();
+
+			#if _LEGGIERO_TASK_TELEMETRY
+				if (isTelemetryEnabled)
+				{
+					Telemetry::RecordTaskStep(typeid(*pTask), TelemetryClock::duration::zero(), TelemetryClock::now() - stepStartTime, taskResult.result);
+				}
+			#endif
+
+			pTask->State().store(pTask->GetTaskState() & (~TaskState::kJobProcessing));
+			if (pTask->HasError())
+			{
+				pTask->State().store(TaskState::kError);
+				ReleaseExecution(execution);
+				return;
+			}
+
+			// Process Scheduling
+			switch (taskResult.result)
+			{
+				case TaskDoneResult::ResultType::kFinished:
+					{
+						pTask->OnAfterProcess();
+						pTask->State().store(pTask->HasError() ? TaskState::kError : TaskState::kDone);
+						ReleaseExecution(execution);
+					}
+					break;
+
+				case TaskDoneResult::ResultType::kYield:
+					{
+						Utility::Threading::ScopedMutexLock lockContext(m_queueLock);
+						_PushReady(execution);
+					}
+					break;
+
+				case TaskDoneResult::ResultType::kSleep:
+					{
+						RequestDelayedExecution(execution, taskResult.duration);
+					}
+					break;
+
+				case TaskDoneResult::ResultType::kWaitCondition:
+					{
+						RequestExecution(execution);
+					}
+					break;
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		void DeterministicTaskManager::_CancelExecution(TaskExecutionEntry *execution)
+		{
+			if (execution->task)
+			{
+				ITask &task = *(execution->task);
+				if (!task.IsFinished())
+				{
+					task.SetErrorFlag();
+					task.State().store(TaskState::kError);
+				}
+			}
+			ReleaseExecution(execution);
+		}
+	}
+}
@@ -0,0 +1,142 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// DeterministicTaskManager.h (Leggiero/Modules - Task)
+//
+// Single-threaded task manager with virtual scheduling clock
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__DETERMINISTIC_TASK_MANAGER_H
+#define __LM_TASK__DETERMINISTIC_TASK_MANAGER_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// Leggiero.Engine
+#include <Engine/Application/GameProcessAnchorObserver.h>
+
+// Leggiero.Utility
+#include <Utility/Threading/ManagedThreadPrimitives.h>
+
+// Leggiero.Task
+#include "TaskManagerComponent.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		// Task manager running every task inline on the stepping thread in a deterministic order
+		// Sleeps and condition waits are resolved against a virtual clock which advances only by request.
+		// For reproducible replays and benchmarks; no worker thread or processor is created,
+		// so tasks of every capability run on the stepping thread.
+		class DeterministicTaskManager
+			: public TaskManagerComponent
+			, public Engine::GameProcessAnchorObserver::IAfterFrameHandler
+		{
+		public:
+			// If frameTimeStep is positive, each game frame advances the virtual clock by the step and runs one pass of ready tasks
+			DeterministicTaskManager(SchedulingClock::duration frameTimeStep = SchedulingClock::duration::zero());
+			virtual ~DeterministicTaskManager();
+
+		public:	// EngineComponent
+			// Initialize the Component
+			virtual void InitializeComponent(Engine::GameProcessAnchor *gameAnchor) override;
+
+			// Safely Shutdown Component
+			virtual void ShutdownComponent() override;
+
+		public:	// ITaskManagerSystemFunctions
+			virtual void AttachSubSystem(std::shared_ptr<ITaskSubSystem> /*subSystem*/) override { }
+			virtual void AddGeneralWorkerCapability(TaskCapabilityType /*capabilities*/) override { }
+
+			virtual void RequestExecution(TaskExecutionEntry *execution) override;
+			virtual void RequestDelayedExecution(TaskExecutionEntry *execution, SchedulingClock::duration delay) override;
+
+			virtual void ReleaseExecution(TaskExecutionEntry *execution) override;
+
+		public:	// TaskManagerComponent
+			virtual bool ExecuteTask(std::shared_ptr<ITask> task) override;
+			virtual size_t ExecuteTasks(const std::shared_ptr<ITask> *tasks, size_t taskCount) override;
+
+			virtual void GetTelemetrySnapshot(TaskTelemetrySnapshot &outSnapshot) override;
+
+		public:	// IAfterFrameHandler
+			virtual void GameProcess_OnAfterFrame(GameFrameNumberType frameNumber) override;
+
+		public:	// Virtual Clock
+			SchedulingClock::time_point GetVirtualTime();
+			void AdvanceVirtualTime(SchedulingClock::duration duration);
+
+			// Jump the virtual clock to the earliest sleeping task; returns false if nothing is sleeping
+			bool AdvanceToNextWakeUp();
+
+			// Set the deadline of a task to the timeout from the current virtual time
+			// Deadlines from SchedulingClock::now() are never reached by the virtual clock.
+			void SetVirtualDeadline(ITask &task, SchedulingClock::duration timeout);
+
+		public:	// Processing
+			// Process one step of every task ready at the start of the pass, in priority then submission order
+			// Tasks yielded or newly requested during the pass are processed in the next pass.
+			size_t RunReadySteps(size_t maxSteps = std::numeric_limits<size_t>::max());
+
+			// Repeat passes without advancing the virtual clock until no task is ready
+			// Never returns while a task keeps yielding, unless maxSteps is given.
+			size_t RunUntilIdle(size_t maxSteps = std::numeric_limits<size_t>::max());
+
+			// Advance the virtual clock by the tick and run until idle, repeatedly for the duration
+			size_t RunFor(SchedulingClock::duration duration, SchedulingClock::duration tick, size_t maxSteps = std::numeric_limits<size_t>::max());
+
+			size_t GetPendingTaskCount();
+
+		protected:
+			struct SleepingEntry
+			{
+			public:
+				SchedulingClock::time_point	wakeTime;
+				uint64_t					sequence;
+				TaskExecutionEntry			*execution;
+
+			public:
+				bool operator>(const SleepingEntry &other) const { return ((wakeTime != other.wakeTime) ? (wakeTime > other.wakeTime) : (sequence > other.sequence)); }
+			};
+
+			static constexpr int kPriorityLaneCount = 3;
+
+		protected:
+			static int _GetPriorityLane(TaskExecutionEntry *execution);
+
+			void _PushReady(TaskExecutionEntry *execution);
+			TaskExecutionEntry *_PopPassEntry();
+			void _PromoteWaitingExecutions();
+			void _SweepCancelledSleepingExecutions();
+
+			void _ProcessStep(TaskExecutionEntry *execution);
+			void _CancelExecution(TaskExecutionEntry *execution);
+
+		protected:
+			Engine::GameProcessAnchor			*m_gameAnchor;
+			SchedulingClock::duration			m_frameTimeStep;
+
+			Utility::Threading::SafePthreadLock	m_queueLock;
+
+			SchedulingClock::time_point			m_virtualNow;
+			uint64_t							m_sleepingSequence;
+			uint64_t							m_sweptCancellationEpoch;
+
+			std::deque<TaskExecutionEntry *>	m_readyQueues[kPriorityLaneCount];
+			std::deque<TaskExecutionEntry *>	m_passQueue;
+			std::vector<TaskExecutionEntry *>	m_conditionWaitingList;
+			std::vector<SleepingEntry>			m_sleepingHeap;
+		};
+	}
+}
+
+#endif
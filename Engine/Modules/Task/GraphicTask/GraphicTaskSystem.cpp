@@ -7,10 +7,19 @@
 // My Header
 #include "GraphicTaskSystem.h"
 
+// Standard Library
+#include <unordered_map>
+
+// Leggiero.Utility
+#include <Utility/Threading/ManagedThreadPrimitives.h>
+
 // Leggiero.Engine
 #include <Engine/Application/GameProcessAnchor.h>
 #include <Engine/Application/GameProcessAnchorObserver.h>
 
+// Leggiero.Graphics
+#include <Graphics/Texture/TextureHelper.h>
+
 // Leggiero.Task
 #include "../TaskManagerComponent.h"
 #include "../TaskSubSystemInterface.h"
@@ -46,9 +55,20 @@ namespace Leggiero
 			public:	// IGraphicPrepareHandler
 				virtual void GameProcess_OnGraphicPrepare(bool isFirstGraphicPrepare) override;
 
+			public:
+				void SetFrameBudget(GameTimeClockType::duration timeBudget, size_t uploadByteBudget);
+				void DisableFrameBudget();
+
+				bool GetFrameStatus(GraphicTaskFrameStatus &outStatus);
+
 			protected:
 				int m_initialThreadCount;
 
+				// Budget can be set before the processor created
+				bool m_isFrameBudgeted;
+				GameTimeClockType::duration m_frameTimeBudget;
+				size_t m_frameUploadByteBudget;
+
 				TaskManagerComponent *m_ownerManager;
 				Application::ApplicationComponent *m_appComponentCopy;
 				Engine::GameProcessAnchor *m_gameAnchorCopy;
@@ -56,15 +76,62 @@ namespace Leggiero
 				std::shared_ptr<GraphicTask::GraphicThreadWorkerPool> m_graphicProcessor;
 			};
 
+			//------------------------------------------------------------------------------
+			// Sub-systems by owner manager, to find the sub-system from public functions
+			namespace
+			{
+				Utility::Threading::SafePthreadLock g_subSystemRegistryLock;
+				std::unordered_map<TaskManagerComponent *, GraphicTaskSubSystem *> g_subSystemRegistry;
+
+				//------------------------------------------------------------------------------
+				void _RegisterSubSystem(TaskManagerComponent *ownerManager, GraphicTaskSubSystem *subSystem)
+				{
+					Utility::Threading::ScopedMutexLock lockContext(g_subSystemRegistryLock);
+					g_subSystemRegistry[ownerManager] = subSystem;
+				}
+
+				//------------------------------------------------------------------------------
+				void _UnRegisterSubSystem(TaskManagerComponent *ownerManager, GraphicTaskSubSystem *subSystem)
+				{
+					if (ownerManager == nullptr)
+					{
+						return;
+					}
+
+					Utility::Threading::ScopedMutexLock lockContext(g_subSystemRegistryLock);
+					auto findIt = g_subSystemRegistry.find(ownerManager);
+					if (findIt != g_subSystemRegistry.end() && findIt->second == subSystem)
+					{
+						g_subSystemRegistry.erase(findIt);
+					}
+				}
+
+				//------------------------------------------------------------------------------
+				// Should be called in the registry lock
+				GraphicTaskSubSystem *_FindSubSystem(TaskManagerComponent *ownerManager)
+				{
+					auto findIt = g_subSystemRegistry.find(ownerManager);
+					if (findIt == g_subSystemRegistry.end())
+					{
+						return nullptr;
+					}
+					return findIt->second;
+				}
+			}
+
 			//------------------------------------------------------------------------------
 			GraphicTaskSubSystem::GraphicTaskSubSystem(int initialThreadCount)
 				: m_initialThreadCount(initialThreadCount)
+				, m_isFrameBudgeted(false), m_frameTimeBudget(GameTimeClockType::duration::zero()), m_frameUploadByteBudget(0)
+				, m_ownerManager(nullptr), m_appComponentCopy(nullptr), m_gameAnchorCopy(nullptr)
 			{
 			}
 
 			//------------------------------------------------------------------------------
 			GraphicTaskSubSystem::~GraphicTaskSubSystem()
 			{
+				_UnRegisterSubSystem(m_ownerManager, this);
+
 				if (m_gameAnchorCopy != nullptr)
 				{
 					m_gameAnchorCopy->UnRegisterOnGraphicPrepare(this);
@@ -85,12 +152,18 @@ namespace Leggiero
 				m_gameAnchorCopy = gameAnchor;
 
 				gameAnchor->RegisterOnGraphicPrepare(this);
+
+				_RegisterSubSystem(ownerManager, this);
 			}
 
 			//------------------------------------------------------------------------------
 			void GraphicTaskSubSystem::CreateProcessors(std::function<void(std::shared_ptr<ITaskProcessor>)> registerFunc)
 			{
 				m_graphicProcessor = std::make_shared<GraphicTask::GraphicThreadWorkerPool>(m_ownerManager, m_appComponentCopy, m_gameAnchorCopy);
+				if (m_isFrameBudgeted)
+				{
+					m_graphicProcessor->EnableFrameBudget(m_frameTimeBudget, m_frameUploadByteBudget);
+				}
 				registerFunc(m_graphicProcessor);
 			}
 
@@ -115,6 +188,44 @@ namespace Leggiero
 				}
 			}
 
+			//------------------------------------------------------------------------------
+			void GraphicTaskSubSystem::SetFrameBudget(GameTimeClockType::duration timeBudget, size_t uploadByteBudget)
+			{
+				m_isFrameBudgeted = true;
+				m_frameTimeBudget = timeBudget;
+				m_frameUploadByteBudget = uploadByteBudget;
+
+				if (m_graphicProcessor)
+				{
+					m_graphicProcessor->EnableFrameBudget(timeBudget, uploadByteBudget);
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicTaskSubSystem::DisableFrameBudget()
+			{
+				m_isFrameBudgeted = false;
+
+				if (m_graphicProcessor)
+				{
+					m_graphicProcessor->DisableFrameBudget();
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			bool GraphicTaskSubSystem::GetFrameStatus(GraphicTaskFrameStatus &outStatus)
+			{
+				if (!m_graphicProcessor)
+				{
+					outStatus = GraphicTaskFrameStatus();
+					outStatus.isFrameBudgeted = m_isFrameBudgeted;
+					return false;
+				}
+
+				m_graphicProcessor->GetFrameStatus(outStatus);
+				return true;
+			}
+
 
 			//////////////////////////////////////////////////////////////////////////////// Graphic Task System
 
@@ -134,6 +245,50 @@ namespace Leggiero
 				}
 
 				taskManager->AttachSubSystem(std::make_shared<GraphicTaskSubSystem>(graphicThreadCount));
+
+				// Texture and glyph uploads of the engine done in graphic tasks count for the frame budget
+				Graphics::Texture::SetTextureUploadReporter(&ReportGraphicUploadBytes);
+			}
+
+			//------------------------------------------------------------------------------
+			void SetGraphicTaskFrameBudget(TaskManagerComponent *taskManager, GameTimeClockType::duration timeBudget, size_t uploadByteBudget)
+			{
+				Utility::Threading::ScopedMutexLock lockContext(g_subSystemRegistryLock);
+				GraphicTaskSubSystem *subSystem = _FindSubSystem(taskManager);
+				if (subSystem != nullptr)
+				{
+					subSystem->SetFrameBudget(timeBudget, uploadByteBudget);
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			void DisableGraphicTaskFrameBudget(TaskManagerComponent *taskManager)
+			{
+				Utility::Threading::ScopedMutexLock lockContext(g_subSystemRegistryLock);
+				GraphicTaskSubSystem *subSystem = _FindSubSystem(taskManager);
+				if (subSystem != nullptr)
+				{
+					subSystem->DisableFrameBudget();
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			bool GetGraphicTaskFrameStatus(TaskManagerComponent *taskManager, GraphicTaskFrameStatus &outStatus)
+			{
+				Utility::Threading::ScopedMutexLock lockContext(g_subSystemRegistryLock);
+				GraphicTaskSubSystem *subSystem = _FindSubSystem(taskManager);
+				if (subSystem == nullptr)
+				{
+					outStatus = GraphicTaskFrameStatus();
+					return false;
+				}
+				return subSystem->GetFrameStatus(outStatus);
+			}
+
+			//------------------------------------------------------------------------------
+			void ReportGraphicUploadBytes(size_t uploadBytes)
+			{
+				GraphicThreadWorkerPool::ChargeCurrentThreadUploadBytes(uploadBytes);
 			}
 		}
 	}
@@ -11,6 +11,9 @@
 // Leggiero.Basic
 #include <Basic/LeggieroBasic.h>
 
+// Standard Library
+#include <cstddef>
+
 
 namespace Leggiero
 {
@@ -22,8 +25,36 @@ namespace Leggiero
 
 		namespace GraphicTask
 		{
+			// Status of graphic work, to see how much work is pending
+			struct GraphicTaskFrameStatus
+			{
+			public:
+				bool	isFrameBudgeted = false;
+				size_t	pendingJobCount = 0;
+
+				// Measured in the last finished frame
+				GameTimeClockType::duration	lastFrameWorkTime = GameTimeClockType::duration::zero();
+				size_t						lastFrameUploadedBytes = 0;
+				size_t						lastFrameProcessedJobCount = 0;
+
+				// Count of consecutive frames finished with the budget spent and jobs left
+				int		deferredFrameCount = 0;
+			};
+
+
 			// Enable Graphic Task System for the task manager
 			void EnableGraphicTaskSystem(TaskManagerComponent *taskManager, int graphicThreadCount = 4);
+
+			// Spread graphic work over frames: GL work started in a frame is capped by time spent and bytes uploaded
+			// Left jobs wait for the next frame, high priority tasks first. uploadByteBudget of 0 means no limit by bytes.
+			void SetGraphicTaskFrameBudget(TaskManagerComponent *taskManager, GameTimeClockType::duration timeBudget, size_t uploadByteBudget = 0);
+			void DisableGraphicTaskFrameBudget(TaskManagerComponent *taskManager);
+
+			bool GetGraphicTaskFrameStatus(TaskManagerComponent *taskManager, GraphicTaskFrameStatus &outStatus);
+
+			// Report bytes uploaded by the running graphic task, to be counted for the frame budget
+			// Ignored when not called in a graphic task. Texture uploads of Graphics module are reported by themselves.
+			void ReportGraphicUploadBytes(size_t uploadBytes);
 		}
 	}
 }
@@ -16,6 +16,9 @@
 // Leggiero.Graphics
 #include <Graphics/GraphicsThreadContext.h>
 
+// Leggiero.Task
+#include "GraphicThreadWorkerPool.h"
+
 
 namespace Leggiero
 {
@@ -26,8 +29,8 @@ namespace Leggiero
 			//////////////////////////////////////////////////////////////////////////////// GraphicThreadWorker
 
 			//------------------------------------------------------------------------------
-			GraphicThreadWorker::GraphicThreadWorker(IThreadWorkerContext *pOwnerContext, Engine::GameProcessAnchor *gameAnchor)
-				: ThreadWorker(pOwnerContext), m_gameAnchor(gameAnchor)
+			GraphicThreadWorker::GraphicThreadWorker(GraphicThreadWorkerPool *pOwnerPool, Engine::GameProcessAnchor *gameAnchor)
+				: ThreadWorker(pOwnerPool), m_pOwnerPool(pOwnerPool), m_gameAnchor(gameAnchor)
 				, m_isSubscribed(false), m_checkAndRefreshRequested(false)
 			{
 			}
@@ -71,10 +74,19 @@ namespace Leggiero
 				}
 			}
 
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorker::_PreProcessBeforeTask()
+			{
+				m_stepStartTime = GameTimeClockType::now();
+			}
+
 			//------------------------------------------------------------------------------
 			void GraphicThreadWorker::_PostProcessAfterTask()
 			{
 				glFinish();
+
+				// Measured after finish, to count the driver work of the step
+				m_pOwnerPool->ChargeWorkTime(GameTimeClockType::now() - m_stepStartTime);
 			}
 
 			//------------------------------------------------------------------------------
@@ -40,19 +40,24 @@ namespace Leggiero
 	{
 		namespace GraphicTask
 		{
+			// Forward Declaration
+			class GraphicThreadWorkerPool;
+
+
 			// Graphic Thread Worker
 			class GraphicThreadWorker
 				: public ThreadWorker
 				, public Engine::GameProcessAnchorObserver::IGraphicPrepareHandler
 			{
 			public:
-				GraphicThreadWorker(IThreadWorkerContext *pOwnerContext, Engine::GameProcessAnchor *gameAnchor);
+				GraphicThreadWorker(GraphicThreadWorkerPool *pOwnerPool, Engine::GameProcessAnchor *gameAnchor);
 				virtual ~GraphicThreadWorker();
 
 			protected:	// ThreadWorker
 				virtual bool _InitializeBeforeWork() override;
 				virtual void _FinalizeAfterWork() override;
 
+				virtual void _PreProcessBeforeTask() override;
 				virtual void _PostProcessAfterTask() override;
 
 				virtual bool _LoopProcess() override;
@@ -61,9 +66,14 @@ namespace Leggiero
 				virtual void GameProcess_OnGraphicPrepare(bool isFirstGraphicPrepare) override;
 
 			protected:
+				GraphicThreadWorkerPool *m_pOwnerPool;
+
 				Engine::GameProcessAnchor *m_gameAnchor;
 				bool m_isSubscribed;
 
+				// Start of the running task step, to charge its GL work to the frame budget
+				GameTimeClockType::time_point m_stepStartTime;
+
 				std::shared_ptr<Graphics::IGLThreadContextInformation> m_graphicsContext;
 
 				std::atomic_bool m_checkAndRefreshRequested;
@@ -17,12 +17,24 @@ namespace Leggiero
 	{
 		namespace GraphicTask
 		{
+			//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+			namespace _Internal
+			{
+				// Pool of the graphic worker running on current thread
+				thread_local GraphicThreadWorkerPool *t_currentWorkerPool = nullptr;
+			}
+
+
 			//////////////////////////////////////////////////////////////////////////////// GraphicThreadWorkerPool
 
 			//------------------------------------------------------------------------------
 			GraphicThreadWorkerPool::GraphicThreadWorkerPool(ITaskManagerSystemFunctions *pManager, Application::ApplicationComponent *appComponent, Engine::GameProcessAnchor *gameAnchor)
 				: ThreadWorkerPool(pManager, appComponent)
 				, m_gameAnchor(gameAnchor)
+				, m_isFrameBudgeted(false), m_frameTimeBudget(0), m_frameUploadByteBudget(0)
+				, m_frameWorkTime(0), m_frameUploadedBytes(0), m_frameProcessedJobCount(0)
+				, m_lastFrameWorkTime(GameTimeClockType::duration::zero()), m_lastFrameUploadedBytes(0), m_lastFrameProcessedJobCount(0), m_deferredFrameCount(0)
 			{
 			}
 
@@ -42,6 +54,162 @@ namespace Leggiero
 				}
 				return createdWorker;
 			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::OnWorkerThreadStart(ThreadWorker *worker)
+			{
+				ThreadWorkerPool::OnWorkerThreadStart(worker);
+				_Internal::t_currentWorkerPool = this;
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::OnWorkerThreadFinish(ThreadWorker *worker)
+			{
+				_Internal::t_currentWorkerPool = nullptr;
+				ThreadWorkerPool::OnWorkerThreadFinish(worker);
+			}
+
+			//------------------------------------------------------------------------------
+			// Hold jobs in the queue while the budget of current frame is spent
+			TaskExecutionEntry *GraphicThreadWorkerPool::DequeueJob()
+			{
+				if (_IsFrameBudgetSpent())
+				{
+					return nullptr;
+				}
+
+				TaskExecutionEntry *dequeuedJob = ThreadWorkerPool::DequeueJob();
+				if (dequeuedJob != nullptr)
+				{
+					m_frameProcessedJobCount.fetch_add(1, std::memory_order_relaxed);
+				}
+				return dequeuedJob;
+			}
+
+			//------------------------------------------------------------------------------
+			bool GraphicThreadWorkerPool::IsQueueEmptyRoughly()
+			{
+				// Let workers sleep until the next frame wakes them up
+				if (_IsFrameBudgetSpent())
+				{
+					return true;
+				}
+				return ThreadWorkerPool::IsQueueEmptyRoughly();
+			}
+
+			//------------------------------------------------------------------------------
+			// Called on the game thread after each frame; starts budget of the next frame
+			void GraphicThreadWorkerPool::UpdateProcessor()
+			{
+				ThreadWorkerPool::UpdateProcessor();
+
+				bool wasBudgetSpent = _IsFrameBudgetSpent();
+
+				m_lastFrameWorkTime = GameTimeClockType::duration(m_frameWorkTime.exchange(0, std::memory_order_relaxed));
+				m_lastFrameUploadedBytes = m_frameUploadedBytes.exchange(0, std::memory_order_relaxed);
+				m_lastFrameProcessedJobCount = m_frameProcessedJobCount.exchange(0, std::memory_order_relaxed);
+
+				if (!IsFrameBudgeted())
+				{
+					m_deferredFrameCount = 0;
+					return;
+				}
+
+				if (wasBudgetSpent && !ThreadWorkerPool::IsQueueEmptyRoughly())
+				{
+					++m_deferredFrameCount;
+
+					// Workers slept on the spent budget
+					pthread_cond_broadcast(&m_queueCondition.GetConditionVariable());
+				}
+				else
+				{
+					m_deferredFrameCount = 0;
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// GraphicThreadWorkerPool - Frame Budget
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::EnableFrameBudget(GameTimeClockType::duration timeBudget, size_t uploadByteBudget)
+			{
+				if (timeBudget <= GameTimeClockType::duration::zero())
+				{
+					// Zero budget cannot make progress
+					timeBudget = std::chrono::microseconds(1);
+				}
+
+				m_frameTimeBudget.store(timeBudget.count(), std::memory_order_relaxed);
+				m_frameUploadByteBudget.store(uploadByteBudget, std::memory_order_relaxed);
+				m_isFrameBudgeted.store(true, std::memory_order_release);
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::DisableFrameBudget()
+			{
+				bool wasBudgeted = m_isFrameBudgeted.exchange(false, std::memory_order_acq_rel);
+				if (wasBudgeted)
+				{
+					pthread_cond_broadcast(&m_queueCondition.GetConditionVariable());
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::GetFrameStatus(GraphicTaskFrameStatus &outStatus)
+			{
+				outStatus.isFrameBudgeted = IsFrameBudgeted();
+				outStatus.pendingJobCount = GetApproxQueueSize();
+				outStatus.lastFrameWorkTime = m_lastFrameWorkTime;
+				outStatus.lastFrameUploadedBytes = m_lastFrameUploadedBytes;
+				outStatus.lastFrameProcessedJobCount = m_lastFrameProcessedJobCount;
+				outStatus.deferredFrameCount = m_deferredFrameCount;
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::ChargeWorkTime(GameTimeClockType::duration workTime)
+			{
+				m_frameWorkTime.fetch_add(workTime.count(), std::memory_order_relaxed);
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::ChargeUploadBytes(size_t uploadBytes)
+			{
+				m_frameUploadedBytes.fetch_add(uploadBytes, std::memory_order_relaxed);
+			}
+
+			//------------------------------------------------------------------------------
+			void GraphicThreadWorkerPool::ChargeCurrentThreadUploadBytes(size_t uploadBytes)
+			{
+				GraphicThreadWorkerPool *currentPool = _Internal::t_currentWorkerPool;
+				if (currentPool == nullptr)
+				{
+					return;
+				}
+				currentPool->ChargeUploadBytes(uploadBytes);
+			}
+
+			//------------------------------------------------------------------------------
+			bool GraphicThreadWorkerPool::_IsFrameBudgetSpent() const
+			{
+				if (!m_isFrameBudgeted.load(std::memory_order_acquire))
+				{
+					return false;
+				}
+
+				if (m_frameWorkTime.load(std::memory_order_relaxed) >= m_frameTimeBudget.load(std::memory_order_relaxed))
+				{
+					return true;
+				}
+
+				size_t uploadByteBudget = m_frameUploadByteBudget.load(std::memory_order_relaxed);
+				if (uploadByteBudget > 0 && m_frameUploadedBytes.load(std::memory_order_relaxed) >= uploadByteBudget)
+				{
+					return true;
+				}
+
+				return false;
+			}
 		}
 	}
 }
@@ -11,8 +11,14 @@
 // Leggiero.Basic
 #include <Basic/LeggieroBasic.h>
 
+// Standard Library
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 // Leggiero.Task
 #include "../Processor/ThreadWorkerPool.h"
+#include "GraphicTaskSystem.h"
 
 
 namespace Leggiero
@@ -39,15 +45,60 @@ namespace Leggiero
 				GraphicThreadWorkerPool(ITaskManagerSystemFunctions *pManager, Application::ApplicationComponent *appComponent, Engine::GameProcessAnchor *gameAnchor);
 				virtual ~GraphicThreadWorkerPool();
 
+			public:	// Frame Budget
+				// Cap graphic work started in a frame by time and uploaded bytes; uploadByteBudget of 0 means no limit by bytes
+				// A job started within the budget is not interrupted, so a frame can go over by a job per worker.
+				void EnableFrameBudget(GameTimeClockType::duration timeBudget, size_t uploadByteBudget = 0);
+				void DisableFrameBudget();
+
+				bool IsFrameBudgeted() const { return m_isFrameBudgeted.load(std::memory_order_relaxed); }
+
+				void GetFrameStatus(GraphicTaskFrameStatus &outStatus);
+
+				// Charge work done by a worker to the budget of current frame
+				void ChargeWorkTime(GameTimeClockType::duration workTime);
+				void ChargeUploadBytes(size_t uploadBytes);
+
+				// Charge bytes to the pool of the graphic worker running on current thread
+				static void ChargeCurrentThreadUploadBytes(size_t uploadBytes);
+
 			public:	// ITaskProcessor
 				// Get task capability of the processor
 				virtual TaskCapabilityType GetProcessorTaskCapability() override { return TaskCapabilities::kGraphics; }
 
+				virtual void UpdateProcessor() override;
+
+			public:	// IThreadWorkerContext
+				virtual void OnWorkerThreadStart(ThreadWorker *worker) override;
+				virtual void OnWorkerThreadFinish(ThreadWorker *worker) override;
+
+				virtual TaskExecutionEntry *DequeueJob() override;
+				virtual bool IsQueueEmptyRoughly() override;
+
 			protected:	// ThreadWorkerPool
 				virtual ThreadWorker *_CreateWorker() override;
 
+			protected:
+				bool _IsFrameBudgetSpent() const;
+
 			protected:
 				Engine::GameProcessAnchor *m_gameAnchor;
+
+			protected:	// Frame Budget
+				std::atomic_bool					m_isFrameBudgeted;
+				std::atomic<GameTimeClockType::rep>	m_frameTimeBudget;
+				std::atomic<size_t>					m_frameUploadByteBudget;
+
+				// Work of current frame, charged by workers
+				std::atomic<GameTimeClockType::rep>	m_frameWorkTime;
+				std::atomic<size_t>					m_frameUploadedBytes;
+				std::atomic<size_t>					m_frameProcessedJobCount;
+
+				// Result of the last frame, written on the game thread
+				GameTimeClockType::duration	m_lastFrameWorkTime;
+				size_t						m_lastFrameUploadedBytes;
+				size_t						m_lastFrameProcessedJobCount;
+				int							m_deferredFrameCount;
 			};
 		}
 	}
@@ -34,6 +34,9 @@ namespace Leggiero
 					return nullptr;
 				}
 
+				// Resize by load between 2 and the hardware concurrency
+				createdWorkerPool->EnableAdaptiveSizing(2);
+
 				return createdWorkerPool;
 			}
 		}
@@ -13,6 +13,7 @@
 
 // Leggiero.Task
 #include "../TaskTypes.h"
+#include "../TaskTelemetry.h"
 
 
 namespace Leggiero
@@ -33,6 +34,15 @@ namespace Leggiero
 			// Give job to processor
 			virtual void GiveJob(TaskExecutionEntry *job) = 0;
 
+			// Give jobs to processor at once
+			virtual void GiveJobs(TaskExecutionEntry **jobs, size_t jobCount)
+			{
+				for (size_t i = 0; i < jobCount; ++i)
+				{
+					GiveJob(jobs[i]);
+				}
+			}
+
 			// Get task capability of the processor
 			virtual TaskCapabilityType GetProcessorTaskCapability() { return TaskCapabilities::kGeneral; }
 
@@ -41,6 +51,17 @@ namespace Leggiero
 
 		public:
 			virtual void PrepareProcessorShutdown() { }
+
+			// Periodic maintenance, called by the manager on the game thread after each frame
+			virtual void UpdateProcessor() { }
+
+		public:	// Telemetry
+			virtual void FillTelemetry(TaskTelemetrySnapshot::ProcessorEntry &outEntry)
+			{
+				outEntry.capability = GetProcessorTaskCapability();
+				outEntry.queueDepth = 0;
+				outEntry.workers.clear();
+			}
 		};
 	}
 }
@@ -11,6 +11,9 @@
 // Leggiero.Basic
 #include <Basic/LeggieroBasic.h>
 
+// Standard Library
+#include <atomic>
+
 // External Library
 #include <pthread.h>
 
@@ -22,8 +25,9 @@ namespace Leggiero
 {
 	namespace Task
 	{
-		// Forward Declaration
+		// Forward Declarations
 		struct TaskExecutionEntry;
+		class ThreadWorker;
 
 
 		// Thread Worker Context
@@ -39,6 +43,13 @@ namespace Leggiero
 			virtual pthread_mutex_t &PauseMutex() = 0;
 			virtual pthread_cond_t &PauseCondition() = 0;
 
+			// Count of workers waiting on the queue condition
+			virtual std::atomic_int &IdleWorkerCount() = 0;
+
+			// Called in the worker thread around its working loop
+			virtual void OnWorkerThreadStart(ThreadWorker * /*worker*/) { }
+			virtual void OnWorkerThreadFinish(ThreadWorker * /*worker*/) { }
+
 			virtual void HandleDone(TaskExecutionEntry *execution) = 0;
 			virtual void HandleYield(TaskExecutionEntry *execution) = 0;
 			virtual void HandleWait(TaskExecutionEntry *execution, TaskDoneResult waitResult) = 0;
@@ -8,8 +8,8 @@
 #include "ThreadWorker.h"
 
 // Leggiero.Utility
+#include <Utility/Threading/ThreadAffinity.h>
 #include <Utility/Threading/ThreadSleep.h>
-#include <Utility/Sugar/Finally.h>
 
 // Leggiero.Task
 #include "IThreadWorkerContext.h"
@@ -45,8 +45,9 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		ThreadWorker::ThreadWorker(IThreadWorkerContext *pOwnerContext)
 			: m_pOwnerContext(pOwnerContext)
-			, m_isShutdownRequested(false), m_isThreadFinished(true)
+			, m_isShutdownRequested(false), m_isThreadFinished(true), m_isThreadCreated(false)
 			, m_isPauseRequested(false), m_isThreadPaused(false)
+			, m_createdTime(TelemetryClock::now()), m_busyMicroseconds(0), m_processedStepCount(0)
 		{
 			if (pthread_create(&m_workerThread, NULL, ThreadWorker::_ThreadStartHelper, (void *)this) != 0)
 			{
@@ -55,6 +56,7 @@ namespace Leggiero
 				return;
 			}
 
+			m_isThreadCreated = true;
 			m_isThreadFinished.store(false);
 		}
 
@@ -65,6 +67,10 @@ namespace Leggiero
 			if (IsRunning())
 			{
 				RequestStop();
+			}
+			if (m_isThreadCreated)
+			{
+				// Also join already finished thread to release its resources
 				pthread_join(m_workerThread, NULL);
 			}
 		}
@@ -110,9 +116,18 @@ namespace Leggiero
 			m_isPauseRequested.store(false);
 		}
 
+		//------------------------------------------------------------------------------
+		void ThreadWorker::FillTelemetry(TaskTelemetrySnapshot::WorkerEntry &outEntry)
+		{
+			outEntry.busyMicroseconds = m_busyMicroseconds.load(std::memory_order_relaxed);
+			outEntry.aliveMicroseconds = Telemetry::ToMicroseconds(TelemetryClock::now() - m_createdTime);
+		}
+
 		//------------------------------------------------------------------------------
 		void ThreadWorker::_ThreadFunction()
 		{
+			Utility::Threading::PlaceCurrentThread(Utility::Threading::ThreadPlacementRole::kTaskWorker);
+
 			bool initializationResult = _InitializeBeforeWork();
 			if (!initializationResult)
 			{
@@ -121,6 +136,8 @@ namespace Leggiero
 				return;
 			}
 
+			m_pOwnerContext->OnWorkerThreadStart(this);
+
 			_Internal::LoopProcessContext loopContext;
 			while (!m_isShutdownRequested.load())
 			{
@@ -153,6 +170,8 @@ namespace Leggiero
 					break;
 				}
 			}
+
+			m_pOwnerContext->OnWorkerThreadFinish(this);
 			_FinalizeAfterWork();
 
 			m_isThreadFinished.store(true);
@@ -172,6 +191,12 @@ namespace Leggiero
 				m_pOwnerContext->ReleaseNotExecution(execution);
 				return;
 			}
+			if (pTask->IsDropRequested())
+			{
+				pTask->MarkDropped();
+				m_pOwnerContext->HandleError(execution);
+				return;
+			}
 			if (pTask->HasError())
 			{
 				pTask->State().store(TaskState::kError);
@@ -195,15 +220,39 @@ namespace Leggiero
 			// Do Main Task
 			pTask->State().store(pTask->GetTaskState() | TaskState::kJobProcessing);
 
+			#if _LEGGIERO_TASK_TELEMETRY
+				bool isTelemetryEnabled = Telemetry::IsEnabled();
+				TelemetryClock::time_point stepStartTime;
+				if (isTelemetryEnabled)
+				{
+					stepStartTime = TelemetryClock::now();
+				}
+			#endif
+
 			_PreProcessBeforeTask();
 			pTask->OnBeforeStepProcess();
 
 			TaskDoneResult taskResult = pTask->Do();
 			execution->lastStep = SchedulingClock::now();
+			m_processedStepCount.store(m_processedStepCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 
 			pTask->OnAfterStepProcess();
 			_PostProcessAfterTask();
 
+			#if _LEGGIERO_TASK_TELEMETRY
+				if (isTelemetryEnabled)
+				{
+					TelemetryClock::duration stepDuration = TelemetryClock::now() - stepStartTime;
+					m_busyMicroseconds.fetch_add(Telemetry::ToMicroseconds(stepDuration), std::memory_order_relaxed);
+
+					// Executions not stamped (e.g. queued before enabled) are counted with zero latency
+					TelemetryClock::duration startLatency = ((execution->queuedTime.time_since_epoch().count() != 0) ? (stepStartTime - execution->queuedTime) : TelemetryClock::duration::zero());
+					execution->queuedTime = TelemetryClock::time_point();
+
+					Telemetry::RecordTaskStep(typeid(*pTask), startLatency, stepDuration, taskResult.result);
+				}
+			#endif
+
 			pTask->State().store(pTask->GetTaskState() & (~TaskState::kJobProcessing));
 			if (pTask->HasError())
 			{
@@ -274,21 +323,21 @@ namespace Leggiero
 			timespec waitLimit = Utility::Threading::TimespecAdd(Utility::Threading::GetCurrentSystemTimespec(), loopWait);
 
 			// Wait
-			int loopCondLockResult = pthread_mutex_lock(&(m_pOwnerContext->QueueMutex()));
-			if (loopCondLockResult == 0)
+			Utility::Threading::ScopedMutexLock loopCondLockContext(m_pOwnerContext->QueueMutex());
+			if (loopCondLockContext)
 			{
-				pthread_mutex_t *lockCopy = &(m_pOwnerContext->QueueMutex());
-				auto releaseLockFunc = [lockCopy]() mutable { pthread_mutex_unlock(lockCopy); };
-				FINALLY_OF_BLOCK(_RELEASE_LOCK, releaseLockFunc);
-
 				if (!m_isShutdownRequested.load() && !m_isPauseRequested.load())
 				{
 					// Re-check if new entry added during processing
 					//note: this is not strictly synchronized. for worst cases(maybe very rare), the job can get latency as the longest loop delay
+					//note: idle count is raised before the re-check, and producers seeing it signal in the queue lock; the signal cannot fall between the check and the wait
+					std::atomic_int &idleWorkerCount = m_pOwnerContext->IdleWorkerCount();
+					idleWorkerCount.fetch_add(1);
 					if (m_pOwnerContext->IsQueueEmptyRoughly())
 					{
 						pthread_cond_timedwait(&(m_pOwnerContext->QueueCondition()), &(m_pOwnerContext->QueueMutex()), &waitLimit);
 					}
+					idleWorkerCount.fetch_sub(1);
 				}
 			}
 			else
@@ -331,13 +380,9 @@ namespace Leggiero
 			// Loop for deal with spurious wakeup
 			while (m_isPauseRequested.load())
 			{
-				int pauseCondLockResult = pthread_mutex_lock(&(m_pOwnerContext->PauseMutex()));
-				if (pauseCondLockResult == 0)
+				Utility::Threading::ScopedMutexLock pauseCondLockContext(m_pOwnerContext->PauseMutex());
+				if (pauseCondLockContext)
 				{
-					pthread_mutex_t *lockCopy = &(m_pOwnerContext->PauseMutex());
-					auto releaseLockFunc = [lockCopy]() mutable { pthread_mutex_unlock(lockCopy); };
-					FINALLY_OF_BLOCK(_RELEASE_LOCK, releaseLockFunc);
-
 					if (m_isPauseRequested.load())
 					{
 						m_isThreadPaused.store(true);
@@ -22,6 +22,7 @@
 
 // Leggiero.Task
 #include "../TaskTypes.h"
+#include "../TaskTelemetry.h"
 
 
 namespace Leggiero
@@ -55,6 +56,11 @@ namespace Leggiero
 			void RequestPause();
 			void RequestResume();
 
+			void FillTelemetry(TaskTelemetrySnapshot::WorkerEntry &outEntry);
+
+			// Count of processed task steps; always counted for pool sizing
+			uint64_t GetProcessedStepCount() const { return m_processedStepCount.load(std::memory_order_relaxed); }
+
 		protected:	// To modify behavior by sub-classes
 			virtual bool _InitializeBeforeWork() { return true; }
 			virtual void _FinalizeAfterWork() { }
@@ -83,9 +89,17 @@ namespace Leggiero
 			std::atomic_bool	m_isShutdownRequested;
 			std::atomic_bool	m_isThreadFinished;
 			pthread_t			m_workerThread;
+			bool				m_isThreadCreated;
 
 			std::atomic_bool	m_isPauseRequested;
 			std::atomic_bool	m_isThreadPaused;
+
+		protected:	// Telemetry
+			TelemetryClock::time_point	m_createdTime;
+			std::atomic<uint64_t>		m_busyMicroseconds;
+
+			// Written only by the worker thread
+			std::atomic<uint64_t>		m_processedStepCount;
 		};
 	}
 }
@@ -8,6 +8,8 @@
 #include "ThreadWorkerPool.h"
 
 // Standard Library
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 // Leggiero.Utility
@@ -29,12 +31,34 @@ namespace Leggiero
 {
 	namespace Task
 	{
+		//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+		namespace _Internal
+		{
+			// Local queue of the worker running on current thread
+			thread_local ThreadWorkerPool	*t_localQueueOwnerPool = nullptr;
+			thread_local int				t_localQueueSlotIndex = -1;
+
+			// Dequeue count of current thread, to give the background lane a turn
+			thread_local int t_backgroundLaneTurnCounter = 0;
+		}
+
+
 		//////////////////////////////////////////////////////////////////////////////// ThreadWorkerPool
 
 		//------------------------------------------------------------------------------
 		ThreadWorkerPool::ThreadWorkerPool(ITaskManagerSystemFunctions *pManager, Application::ApplicationComponent *appComponent)
 			: m_pManager(pManager), m_appComponentCopy(appComponent)
+			, m_idleWorkerCount(0)
+			, m_localQueueCount(0), m_stealStartIndex(0)
+			, m_isAdaptiveSizing(false), m_adaptiveMinWorkerCount(1), m_adaptiveMaxWorkerCount(1)
+			, m_lastProcessedStepCount(0), m_pressureSampleCount(0), m_idleSampleCount(0)
 		{
+			for (int i = 0; i < kMaxLocalQueueCount; ++i)
+			{
+				m_localQueues[i] = nullptr;
+			}
+
 			appComponent->SystemEventCenter().RegisterApplicationEventObserver(this);
 		}
 
@@ -56,27 +80,41 @@ namespace Leggiero
 			}
 			m_workerList.clear();
 
+			for (ThreadWorker *currentWorker : m_retiringWorkers)
+			{
+				delete currentWorker;
+			}
+			m_retiringWorkers.clear();
+
 			TaskExecutionEntry *dequeuedJob = nullptr;
-			while (m_jobs.try_dequeue(dequeuedJob))
+			for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+			{
+				while (m_jobs[lane].try_dequeue(dequeuedJob))
+				{
+					_CancelJob(dequeuedJob);
+				}
+			}
+
+			int localQueueCount = m_localQueueCount.load();
+			for (int i = 0; i < localQueueCount; ++i)
 			{
-				if (dequeuedJob->task)
+				for (int lane = 0; lane < kPriorityLaneCount; ++lane)
 				{
-					// Cancel Task
-					ITask &task = *(dequeuedJob->task);
-					if (!task.IsFinished())
+					while (m_localQueues[i]->jobs[lane].try_dequeue(dequeuedJob))
 					{
-						task.SetErrorFlag();
-						task.State().store(TaskState::kError);
+						_CancelJob(dequeuedJob);
 					}
 				}
-				m_pManager->ReleaseExecution(dequeuedJob);
+				delete m_localQueues[i];
+				m_localQueues[i] = nullptr;
 			}
+			m_localQueueCount.store(0);
 		}
 
 		//------------------------------------------------------------------------------
 		int ThreadWorkerPool::GetWorkerCount()
 		{
-			auto lockContext = m_workerListLock.Lock();
+			Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 			if (lockContext)
 			{
 				return static_cast<int>(m_workerList.size());
@@ -88,6 +126,46 @@ namespace Leggiero
 			}
 		}
 
+		//------------------------------------------------------------------------------
+		size_t ThreadWorkerPool::GetApproxQueueSize()
+		{
+			size_t queueSize = 0;
+
+			int localQueueCount = m_localQueueCount.load();
+			for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+			{
+				queueSize += m_jobs[lane].size_approx();
+				for (int i = 0; i < localQueueCount; ++i)
+				{
+					queueSize += m_localQueues[i]->jobs[lane].size_approx();
+				}
+			}
+
+			return queueSize;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::FillTelemetry(TaskTelemetrySnapshot::ProcessorEntry &outEntry)
+		{
+			outEntry.capability = GetProcessorTaskCapability();
+			outEntry.queueDepth = GetApproxQueueSize();
+			outEntry.workers.clear();
+
+			Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
+			if (lockContext)
+			{
+				outEntry.workers.reserve(m_workerList.size());
+				for (ThreadWorker *currentWorker : m_workerList)
+				{
+					if (currentWorker != nullptr)
+					{
+						outEntry.workers.emplace_back();
+						currentWorker->FillTelemetry(outEntry.workers.back());
+					}
+				}
+			}
+		}
+
 		//------------------------------------------------------------------------------
 		int ThreadWorkerPool::IncreaseWorker(int increaseCount)
 		{
@@ -124,7 +202,7 @@ namespace Leggiero
 			bool isWorkersAdded = false;
 			for (int i = 0; i < 3; ++i)
 			{
-				auto lockContext = m_workerListLock.Lock();
+				Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 				if (lockContext)
 				{
 					m_workerList.insert(m_workerList.end(), creatingBuffer.begin(), creatingBuffer.end());
@@ -152,7 +230,7 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void ThreadWorkerPool::DecreaseWorker()
 		{
-			auto lockContext = m_workerListLock.Lock();
+			Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 			if (lockContext)
 			{
 				// Only do in lock context
@@ -167,11 +245,122 @@ namespace Leggiero
 			}
 		}
 
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::EnableAdaptiveSizing(int minWorkerCount, int maxWorkerCount)
+		{
+			if (maxWorkerCount <= 0)
+			{
+				maxWorkerCount = static_cast<int>(std::thread::hardware_concurrency());
+			}
+			if (minWorkerCount < 1)
+			{
+				minWorkerCount = 1;
+			}
+
+			m_adaptiveMinWorkerCount = minWorkerCount;
+			m_adaptiveMaxWorkerCount = std::max(minWorkerCount, maxWorkerCount);
+
+			m_lastAdaptiveSampleTime = std::chrono::steady_clock::now();
+			m_lastProcessedStepCount = 0;
+			m_pressureSampleCount = 0;
+			m_idleSampleCount = 0;
+			m_isAdaptiveSizing = true;
+
+			int workerCount = GetWorkerCount();
+			if (workerCount < m_adaptiveMinWorkerCount)
+			{
+				IncreaseWorker(m_adaptiveMinWorkerCount - workerCount);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::DisableAdaptiveSizing()
+		{
+			m_isAdaptiveSizing = false;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::UpdateProcessor()
+		{
+			_CollectRetiredWorkers();
+
+			if (!m_isAdaptiveSizing)
+			{
+				return;
+			}
+
+			std::chrono::steady_clock::time_point currentTime = std::chrono::steady_clock::now();
+			if (currentTime - m_lastAdaptiveSampleTime < kAdaptiveSampleInterval)
+			{
+				return;
+			}
+			_SampleAdaptiveSizing();
+		}
+
 		//------------------------------------------------------------------------------
 		void ThreadWorkerPool::GiveJob(TaskExecutionEntry *job)
 		{
-			m_jobs.enqueue(job);
-			pthread_cond_signal(&m_queueCondition.GetConditionVariable());
+			_EnqueueJob(job);
+			_WakeIdleWorkers(1);
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::GiveJobs(TaskExecutionEntry **jobs, size_t jobCount)
+		{
+			if (jobCount == 0)
+			{
+				return;
+			}
+
+			#if _LEGGIERO_TASK_TELEMETRY
+				if (Telemetry::IsEnabled())
+				{
+					TelemetryClock::time_point queuedTime = TelemetryClock::now();
+					for (size_t i = 0; i < jobCount; ++i)
+					{
+						jobs[i]->queuedTime = queuedTime;
+					}
+				}
+			#endif
+
+			// Usually a batch has jobs of the same priority; split into lanes only if mixed
+			int firstLane = _GetPriorityLane(jobs[0]);
+			bool isMixedLane = false;
+			for (size_t i = 1; i < jobCount; ++i)
+			{
+				if (_GetPriorityLane(jobs[i]) != firstLane)
+				{
+					isMixedLane = true;
+					break;
+				}
+			}
+
+			if (!isMixedLane)
+			{
+				_EnqueueJobsToLane(firstLane, jobs, jobCount);
+			}
+			else
+			{
+				std::vector<TaskExecutionEntry *> laneJobs;
+				laneJobs.reserve(jobCount);
+				for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+				{
+					laneJobs.clear();
+					for (size_t i = 0; i < jobCount; ++i)
+					{
+						if (_GetPriorityLane(jobs[i]) == lane)
+						{
+							laneJobs.push_back(jobs[i]);
+						}
+					}
+					if (!laneJobs.empty())
+					{
+						_EnqueueJobsToLane(lane, laneJobs.data(), laneJobs.size());
+					}
+				}
+			}
+
+			_WakeIdleWorkers(jobCount);
 		}
 
 		//------------------------------------------------------------------------------
@@ -189,7 +378,7 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void ThreadWorkerPool::_CollectInvalidWorkers()
 		{
-			auto lockContext = m_workerListLock.Lock();
+			Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 			if (lockContext)
 			{
 				for (std::list<ThreadWorker *>::iterator it = m_workerList.begin(); it != m_workerList.end(); )
@@ -207,12 +396,28 @@ namespace Leggiero
 			}
 		}
 
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_CancelJob(TaskExecutionEntry *job)
+		{
+			if (job->task)
+			{
+				// Cancel Task
+				ITask &task = *(job->task);
+				if (!task.IsFinished())
+				{
+					task.SetErrorFlag();
+					task.State().store(TaskState::kError);
+				}
+			}
+			m_pManager->ReleaseExecution(job);
+		}
+
 		//------------------------------------------------------------------------------
 		void ThreadWorkerPool::OnGoToBackground()
 		{
 			// Pause workers during app pause
 			{
-				auto lockContext = m_workerListLock.Lock();
+				Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 				for (ThreadWorker *currentWorker : m_workerList)
 				{
 					if (currentWorker != nullptr)
@@ -230,7 +435,7 @@ namespace Leggiero
 		void ThreadWorkerPool::OnReturnFromBackground()
 		{
 			{
-				auto lockContext = m_workerListLock.Lock();
+				Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
 				for (ThreadWorker *currentWorker : m_workerList)
 				{
 					if (currentWorker != nullptr)
@@ -244,6 +449,128 @@ namespace Leggiero
 		}
 
 
+		//////////////////////////////////////////////////////////////////////////////// ThreadWorkerPool - Adaptive Sizing
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_SampleAdaptiveSizing()
+		{
+			std::chrono::steady_clock::time_point sampleTime = std::chrono::steady_clock::now();
+			std::chrono::steady_clock::duration sampleDuration = sampleTime - m_lastAdaptiveSampleTime;
+			m_lastAdaptiveSampleTime = sampleTime;
+
+			// Dead workers should not be counted
+			_CollectInvalidWorkers();
+
+			int workerCount = 0;
+			uint64_t processedStepCount = 0;
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
+				if (!lockContext)
+				{
+					return;
+				}
+				workerCount = static_cast<int>(m_workerList.size());
+				for (ThreadWorker *currentWorker : m_workerList)
+				{
+					processedStepCount += currentWorker->GetProcessedStepCount();
+				}
+			}
+
+			// Counts of retired workers are gone with them
+			uint64_t processedDelta = ((processedStepCount > m_lastProcessedStepCount) ? (processedStepCount - m_lastProcessedStepCount) : 0);
+			m_lastProcessedStepCount = processedStepCount;
+
+			if (workerCount < m_adaptiveMinWorkerCount)
+			{
+				m_pressureSampleCount = 0;
+				m_idleSampleCount = 0;
+				m_lastProcessedStepCount = 0;
+				IncreaseWorker(m_adaptiveMinWorkerCount - workerCount);
+				return;
+			}
+
+			size_t queueSize = GetApproxQueueSize();
+			int idleWorkerCount = m_idleWorkerCount.load();
+
+			// Estimate waiting time of a newly queued job by the throughput of the last interval (Little's law)
+			bool isLatencyHigh = false;
+			if (queueSize > 0)
+			{
+				if (processedDelta == 0)
+				{
+					isLatencyHigh = true;
+				}
+				else
+				{
+					isLatencyHigh = (sampleDuration * static_cast<std::chrono::steady_clock::rep>(queueSize) / static_cast<std::chrono::steady_clock::rep>(processedDelta) >= kPressureWaitLatency);
+				}
+			}
+			bool isUnderPressure = (idleWorkerCount <= 0 && isLatencyHigh && queueSize >= static_cast<size_t>(workerCount) * kPressureQueueDepthPerWorker);
+
+			// A spare worker is allowed to be idle, to absorb bursts
+			bool isMostlyIdle = (queueSize == 0 && idleWorkerCount > 1 && idleWorkerCount * 2 >= workerCount);
+
+			m_pressureSampleCount = (isUnderPressure ? (m_pressureSampleCount + 1) : 0);
+			m_idleSampleCount = (isMostlyIdle ? (m_idleSampleCount + 1) : 0);
+
+			if (m_pressureSampleCount >= kGrowSampleCount)
+			{
+				m_pressureSampleCount = 0;
+				if (workerCount < m_adaptiveMaxWorkerCount)
+				{
+					IncreaseWorker(1);
+				}
+			}
+			else if (m_idleSampleCount >= kShrinkSampleCount)
+			{
+				m_idleSampleCount = 0;
+				if (workerCount > m_adaptiveMinWorkerCount)
+				{
+					_RetireWorker();
+				}
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		// Stop a worker without waiting; it will be deleted after finished
+		void ThreadWorkerPool::_RetireWorker()
+		{
+			ThreadWorker *retiringWorker = nullptr;
+			{
+				Utility::Threading::ScopedMutexLock lockContext(m_workerListLock);
+				if (!lockContext || m_workerList.empty())
+				{
+					return;
+				}
+				retiringWorker = m_workerList.back();
+				m_workerList.pop_back();
+			}
+
+			retiringWorker->RequestStop();
+			m_retiringWorkers.push_back(retiringWorker);
+
+			// Wake the worker if waiting for jobs
+			pthread_cond_broadcast(&m_queueCondition.GetConditionVariable());
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_CollectRetiredWorkers()
+		{
+			for (std::list<ThreadWorker *>::iterator it = m_retiringWorkers.begin(); it != m_retiringWorkers.end(); )
+			{
+				if (!(*it)->IsRunning())
+				{
+					delete (*it);
+					it = m_retiringWorkers.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+
 		//////////////////////////////////////////////////////////////////////////////// ThreadWorkerPool - IThreadWorkerContext
 
 		//------------------------------------------------------------------------------
@@ -255,7 +582,7 @@ namespace Leggiero
 		//------------------------------------------------------------------------------
 		void ThreadWorkerPool::HandleYield(TaskExecutionEntry *execution)
 		{
-			m_jobs.enqueue(execution);
+			_EnqueueJob(execution);
 		}
 
 		//------------------------------------------------------------------------------
@@ -307,20 +634,312 @@ namespace Leggiero
 
 		//------------------------------------------------------------------------------
 		TaskExecutionEntry *ThreadWorkerPool::DequeueJob()
+		{
+			int localSlotIndex = _GetCurrentThreadLocalQueueSlot();
+
+			// High priority lane always first
+			TaskExecutionEntry *dequeuedJob = _DequeueLaneJob(kHighPriorityLane, localSlotIndex);
+			if (dequeuedJob != nullptr)
+			{
+				return dequeuedJob;
+			}
+
+			// Give background lane a turn sometimes, not to be starved by default jobs
+			bool isBackgroundTurn = false;
+			if (++_Internal::t_backgroundLaneTurnCounter >= kBackgroundLaneTurnInterval)
+			{
+				_Internal::t_backgroundLaneTurnCounter = 0;
+				isBackgroundTurn = true;
+			}
+
+			if (isBackgroundTurn)
+			{
+				dequeuedJob = _DequeueLaneJob(kBackgroundLane, localSlotIndex);
+				if (dequeuedJob == nullptr)
+				{
+					dequeuedJob = _DequeueLaneJob(kDefaultLane, localSlotIndex);
+				}
+			}
+			else
+			{
+				dequeuedJob = _DequeueLaneJob(kDefaultLane, localSlotIndex);
+				if (dequeuedJob == nullptr)
+				{
+					dequeuedJob = _DequeueLaneJob(kBackgroundLane, localSlotIndex);
+				}
+			}
+
+			return dequeuedJob;
+		}
+
+		//------------------------------------------------------------------------------
+		bool ThreadWorkerPool::IsQueueEmptyRoughly()
+		{
+			int localQueueCount = m_localQueueCount.load();
+			for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+			{
+				if (m_jobs[lane].size_approx() != 0)
+				{
+					return false;
+				}
+
+				for (int i = 0; i < localQueueCount; ++i)
+				{
+					if (m_localQueues[i]->jobs[lane].size_approx() != 0)
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::OnWorkerThreadStart(ThreadWorker * /*worker*/)
+		{
+			int slotIndex = _AcquireLocalQueueSlot();
+			if (slotIndex < 0)
+			{
+				// No more slot: the worker just uses the shared queue
+				return;
+			}
+
+			_Internal::t_localQueueOwnerPool = this;
+			_Internal::t_localQueueSlotIndex = slotIndex;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::OnWorkerThreadFinish(ThreadWorker * /*worker*/)
+		{
+			int slotIndex = _GetCurrentThreadLocalQueueSlot();
+
+			_Internal::t_localQueueOwnerPool = nullptr;
+			_Internal::t_localQueueSlotIndex = -1;
+
+			if (slotIndex >= 0)
+			{
+				// Left jobs in the queue will be stolen by other workers
+				_ReleaseLocalQueueSlot(slotIndex);
+				for (int lane = 0; lane < kPriorityLaneCount; ++lane)
+				{
+					if (m_localQueues[slotIndex]->jobs[lane].size_approx() > 0)
+					{
+						pthread_cond_broadcast(&m_queueCondition.GetConditionVariable());
+						break;
+					}
+				}
+			}
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// ThreadWorkerPool - Priority Lanes
+
+		//------------------------------------------------------------------------------
+		int ThreadWorkerPool::_GetPriorityLane(TaskExecutionEntry *job)
+		{
+			if (!job->task)
+			{
+				return kDefaultLane;
+			}
+
+			switch (job->task->GetTaskPriority())
+			{
+				case TaskPriorityClass::kHighPriority:
+					return kHighPriorityLane;
+
+				case TaskPriorityClass::kBackground:
+					return kBackgroundLane;
+
+				default:
+					break;
+			}
+			return kDefaultLane;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_EnqueueJob(TaskExecutionEntry *job)
+		{
+			int lane = _GetPriorityLane(job);
+
+			#if _LEGGIERO_TASK_TELEMETRY
+				if (Telemetry::IsEnabled())
+				{
+					job->queuedTime = TelemetryClock::now();
+				}
+			#endif
+
+			// Jobs given in a worker of this pool (continuations) stay local to the worker
+			int localSlotIndex = _GetCurrentThreadLocalQueueSlot();
+			if (localSlotIndex >= 0)
+			{
+				m_localQueues[localSlotIndex]->jobs[lane].enqueue(job);
+			}
+			else
+			{
+				m_jobs[lane].enqueue(job);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_EnqueueJobsToLane(int lane, TaskExecutionEntry **jobs, size_t jobCount)
+		{
+			int localSlotIndex = _GetCurrentThreadLocalQueueSlot();
+			if (localSlotIndex >= 0)
+			{
+				m_localQueues[localSlotIndex]->jobs[lane].enqueue_bulk(jobs, jobCount);
+			}
+			else
+			{
+				m_jobs[lane].enqueue_bulk(jobs, jobCount);
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		// Wake idle workers as many as new jobs; busy workers will find the jobs by themselves
+		void ThreadWorkerPool::_WakeIdleWorkers(size_t newJobCount)
+		{
+			int idleWorkerCount = m_idleWorkerCount.load();
+			if (idleWorkerCount <= 0)
+			{
+				return;
+			}
+
+			// Signal in the queue lock: an idle worker holds it from the re-check of the queue until it starts waiting
+			Utility::Threading::ScopedMutexLock lockContext(m_queueMutex);
+			if (newJobCount >= static_cast<size_t>(idleWorkerCount))
+			{
+				pthread_cond_broadcast(&m_queueCondition.GetConditionVariable());
+				return;
+			}
+
+			for (size_t i = 0; i < newJobCount; ++i)
+			{
+				pthread_cond_signal(&m_queueCondition.GetConditionVariable());
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		TaskExecutionEntry *ThreadWorkerPool::_DequeueLaneJob(int lane, int localSlotIndex)
 		{
 			TaskExecutionEntry *dequeuedJob = nullptr;
-			if (m_jobs.try_dequeue(dequeuedJob))
+
+			// Own queue first
+			if (localSlotIndex >= 0)
+			{
+				if (m_localQueues[localSlotIndex]->jobs[lane].try_dequeue(dequeuedJob))
+				{
+					return dequeuedJob;
+				}
+			}
+
+			if (m_jobs[lane].try_dequeue(dequeuedJob))
+			{
+				return dequeuedJob;
+			}
+
+			// Steal from other workers
+			dequeuedJob = _StealJob(localSlotIndex, lane);
+			if (dequeuedJob != nullptr)
 			{
 				return dequeuedJob;
 			}
 
 			// Try Twice
-			if (m_jobs.try_dequeue(dequeuedJob))
+			if (m_jobs[lane].try_dequeue(dequeuedJob))
 			{
 				return dequeuedJob;
 			}
 
 			return nullptr;
 		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// ThreadWorkerPool - Work Stealing
+
+		//------------------------------------------------------------------------------
+		int ThreadWorkerPool::_AcquireLocalQueueSlot()
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_localQueueSlotLock);
+			if (!lockContext)
+			{
+				return -1;
+			}
+
+			// Reuse released slot
+			int localQueueCount = m_localQueueCount.load();
+			for (int i = 0; i < localQueueCount; ++i)
+			{
+				if (!m_localQueues[i]->isOwned)
+				{
+					m_localQueues[i]->isOwned = true;
+					return i;
+				}
+			}
+
+			if (localQueueCount >= kMaxLocalQueueCount)
+			{
+				return -1;
+			}
+
+			LocalJobQueue *createdQueue = new LocalJobQueue();
+			createdQueue->isOwned = true;
+			m_localQueues[localQueueCount] = createdQueue;
+			m_localQueueCount.store(localQueueCount + 1);
+
+			return localQueueCount;
+		}
+
+		//------------------------------------------------------------------------------
+		void ThreadWorkerPool::_ReleaseLocalQueueSlot(int slotIndex)
+		{
+			Utility::Threading::ScopedMutexLock lockContext(m_localQueueSlotLock);
+			if (!lockContext)
+			{
+				// Just leak the slot
+				return;
+			}
+
+			m_localQueues[slotIndex]->isOwned = false;
+		}
+
+		//------------------------------------------------------------------------------
+		int ThreadWorkerPool::_GetCurrentThreadLocalQueueSlot()
+		{
+			if (_Internal::t_localQueueOwnerPool != this)
+			{
+				return -1;
+			}
+			return _Internal::t_localQueueSlotIndex;
+		}
+
+		//------------------------------------------------------------------------------
+		TaskExecutionEntry *ThreadWorkerPool::_StealJob(int thiefSlotIndex, int lane)
+		{
+			int localQueueCount = m_localQueueCount.load();
+			if (localQueueCount <= 0)
+			{
+				return nullptr;
+			}
+
+			// Spread start victim to avoid every thief hitting the same queue
+			int startIndex = ((thiefSlotIndex >= 0) ? (thiefSlotIndex + 1) : static_cast<int>(m_stealStartIndex.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned int>(localQueueCount)));
+			TaskExecutionEntry *stolenJob = nullptr;
+			for (int i = 0; i < localQueueCount; ++i)
+			{
+				int victimIndex = (startIndex + i) % localQueueCount;
+				if (victimIndex == thiefSlotIndex)
+				{
+					continue;
+				}
+
+				if (m_localQueues[victimIndex]->jobs[lane].try_dequeue(stolenJob))
+				{
+					return stolenJob;
+				}
+			}
+
+			return nullptr;
+		}
 	}
 }
@@ -13,6 +13,7 @@
 
 // Standard Library
 #include <atomic>
+#include <chrono>
 #include <list>
 
 // External Library
@@ -62,18 +63,33 @@ namespace Leggiero
 			int IncreaseWorker(int increaseCount = 1);
 			void DecreaseWorker();
 
-			size_t GetApproxQueueSize() { return m_jobs.size_approx(); }
+			size_t GetApproxQueueSize();
+
+		public:	// Adaptive Sizing
+			// Grow the pool under sustained queue pressure and shrink it while workers are mostly idle, within the bounds
+			// maxWorkerCount <= 0 means the hardware concurrency
+			void EnableAdaptiveSizing(int minWorkerCount, int maxWorkerCount = 0);
+			void DisableAdaptiveSizing();
+
+			bool IsAdaptiveSizing() const { return m_isAdaptiveSizing; }
 
 		public:	// ITaskProcessor
 			// Give job to processor
 			virtual void GiveJob(TaskExecutionEntry *job) override;
 
+			// Give jobs to processor at once
+			virtual void GiveJobs(TaskExecutionEntry **jobs, size_t jobCount) override;
+
 			// Get task capability of the processor
 			virtual TaskCapabilityType GetProcessorTaskCapability() override { return TaskCapabilities::kGeneral; }
 
 			// Is processor handle sleeps of its tasks?
 			virtual bool IsManagingSleeps() override { return false; }
 
+			virtual void UpdateProcessor() override;
+
+			virtual void FillTelemetry(TaskTelemetrySnapshot::ProcessorEntry &outEntry) override;
+
 		public:	// IThreadWorkerContext
 			virtual pthread_mutex_t &QueueMutex() override { return m_queueMutex.GetLock(); }
 			virtual pthread_cond_t &QueueCondition() override { return m_queueCondition.GetConditionVariable(); }
@@ -81,6 +97,11 @@ namespace Leggiero
 			virtual pthread_mutex_t &PauseMutex() override { return m_pauseMutex.GetLock(); }
 			virtual pthread_cond_t &PauseCondition() override { return m_pauseCondition.GetConditionVariable(); }
 
+			virtual std::atomic_int &IdleWorkerCount() override { return m_idleWorkerCount; }
+
+			virtual void OnWorkerThreadStart(ThreadWorker *worker) override;
+			virtual void OnWorkerThreadFinish(ThreadWorker *worker) override;
+
 			virtual void HandleDone(TaskExecutionEntry *execution) override;
 			virtual void HandleYield(TaskExecutionEntry *execution) override;
 			virtual void HandleWait(TaskExecutionEntry *execution, TaskDoneResult waitResult) override;
@@ -89,7 +110,7 @@ namespace Leggiero
 			virtual void ReleaseNotExecution(TaskExecutionEntry *execution) override;
 
 			virtual TaskExecutionEntry *DequeueJob() override;
-			virtual bool IsQueueEmptyRoughly() override { return m_jobs.size_approx() == 0; }
+			virtual bool IsQueueEmptyRoughly() override;
 
 		public:	// Application::IApplicationEventObserver
 			virtual void OnGoToBackground() override;
@@ -100,6 +121,25 @@ namespace Leggiero
 
 		protected:
 			void _CollectInvalidWorkers();
+			void _CancelJob(TaskExecutionEntry *job);
+
+		protected:	// Priority Lanes
+			// Lanes by task priority class, in order of dequeue
+			static constexpr int kPriorityLaneCount = 3;
+			static constexpr int kHighPriorityLane = 0;
+			static constexpr int kDefaultLane = 1;
+			static constexpr int kBackgroundLane = 2;
+
+			// Background lane is checked before default lane once in this count of dequeues, not to be starved
+			static constexpr int kBackgroundLaneTurnInterval = 16;
+
+			static int _GetPriorityLane(TaskExecutionEntry *job);
+
+			void _EnqueueJob(TaskExecutionEntry *job);
+			void _EnqueueJobsToLane(int lane, TaskExecutionEntry **jobs, size_t jobCount);
+
+			void _WakeIdleWorkers(size_t newJobCount);
+			TaskExecutionEntry *_DequeueLaneJob(int lane, int localSlotIndex);
 
 		protected:
 			ITaskManagerSystemFunctions *m_pManager;
@@ -114,7 +154,57 @@ namespace Leggiero
 			Utility::Threading::SafePthreadLock m_workerListLock;
 			std::list<ThreadWorker *>			m_workerList;
 
-			moodycamel::ConcurrentQueue<TaskExecutionEntry *> m_jobs;
+			moodycamel::ConcurrentQueue<TaskExecutionEntry *> m_jobs[kPriorityLaneCount];
+			std::atomic_int m_idleWorkerCount;
+
+		protected:	// Work Stealing
+			static constexpr int kMaxLocalQueueCount = 64;
+
+			// Worker-owned job queue; peers steal from it when they have nothing to do
+			struct LocalJobQueue
+			{
+			public:
+				moodycamel::ConcurrentQueue<TaskExecutionEntry *>	jobs[kPriorityLaneCount];
+				bool												isOwned;
+			};
+
+			// Local queues are never deleted before the pool to allow lock-free stealing
+			LocalJobQueue				*m_localQueues[kMaxLocalQueueCount];
+			std::atomic_int				m_localQueueCount;
+			std::atomic_uint			m_stealStartIndex;
+			Utility::Threading::SafePthreadLock m_localQueueSlotLock;
+
+			int _AcquireLocalQueueSlot();
+			void _ReleaseLocalQueueSlot(int slotIndex);
+			int _GetCurrentThreadLocalQueueSlot();
+
+			TaskExecutionEntry *_StealJob(int thiefSlotIndex, int lane);
+
+		protected:	// Adaptive Sizing
+			// Pressure and idleness are sampled in this interval, and must last for the sample counts to resize
+			static constexpr std::chrono::steady_clock::duration kAdaptiveSampleInterval = std::chrono::milliseconds(50);
+			static constexpr int kGrowSampleCount = 3;
+			static constexpr int kShrinkSampleCount = 40;
+
+			// Pressure means queued jobs more than this per worker, with estimated wait longer than the latency
+			static constexpr size_t kPressureQueueDepthPerWorker = 2;
+			static constexpr std::chrono::steady_clock::duration kPressureWaitLatency = std::chrono::milliseconds(2);
+
+			void _SampleAdaptiveSizing();
+			void _RetireWorker();
+			void _CollectRetiredWorkers();
+
+			bool m_isAdaptiveSizing;
+			int m_adaptiveMinWorkerCount;
+			int m_adaptiveMaxWorkerCount;
+
+			std::chrono::steady_clock::time_point m_lastAdaptiveSampleTime;
+			uint64_t m_lastProcessedStepCount;
+			int m_pressureSampleCount;
+			int m_idleSampleCount;
+
+			// Stopping workers are joined after finished, not to block the game thread
+			std::list<ThreadWorker *> m_retiringWorkers;
 		};
 	}
 }
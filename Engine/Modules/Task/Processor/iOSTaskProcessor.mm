@@ -117,6 +117,12 @@ namespace Leggiero
 						processor->m_pManager->ReleaseExecution(job);
 						return;
 					}
+					if (pTask->IsDropRequested())
+					{
+						pTask->MarkDropped();
+						processor->m_pManager->ReleaseExecution(job);
+						return;
+					}
 					if (pTask->HasError())
 					{
 						pTask->State().store(TaskState::kError);
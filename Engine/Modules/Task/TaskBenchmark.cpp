@@ -0,0 +1,435 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// TaskBenchmark.cpp (Leggiero/Modules - Task)
+//
+// Task system micro-benchmarks implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "TaskBenchmark.h"
+
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// Leggiero.Task
+#include "TaskManagerComponent.h"
+#include "Tasks/DependentTask.h"
+#include "Tasks/PooledActionTask.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+		namespace _Internal
+		{
+			namespace
+			{
+				using BenchmarkClock = std::chrono::steady_clock;
+
+				// Tasks are submitted in batches of this size for throughput cases
+				constexpr size_t kBenchmarkSubmitBatchSize = 256;
+
+				//------------------------------------------------------------------------------
+				double ToBenchmarkMicroseconds(BenchmarkClock::duration duration)
+				{
+					return std::chrono::duration<double, std::micro>(duration).count();
+				}
+
+				//------------------------------------------------------------------------------
+				// Wait by yielding until the condition met; returns false if timed out
+				template <typename ConditionFuncT>
+				bool WaitBenchmarkCondition(ConditionFuncT condition, BenchmarkClock::duration timeout)
+				{
+					BenchmarkClock::time_point waitLimit = BenchmarkClock::now() + timeout;
+					while (!condition())
+					{
+						if (BenchmarkClock::now() > waitLimit)
+						{
+							return false;
+						}
+						std::this_thread::yield();
+					}
+					return true;
+				}
+
+				//------------------------------------------------------------------------------
+				void FillThroughput(TaskBenchmarkResult &result, uint64_t operationCount, BenchmarkClock::duration elapsed)
+				{
+					result.operationCount = operationCount;
+					result.elapsedMicroseconds = ToBenchmarkMicroseconds(elapsed);
+					if (operationCount > 0)
+					{
+						result.nanosecondsPerOperation = result.elapsedMicroseconds * 1000.0 / static_cast<double>(operationCount);
+					}
+					if (result.elapsedMicroseconds > 0.0)
+					{
+						result.operationsPerSecond = static_cast<double>(operationCount) * 1000000.0 / result.elapsedMicroseconds;
+					}
+				}
+
+				//------------------------------------------------------------------------------
+				void FillLatencyDistribution(TaskBenchmarkResult &result, std::vector<double> &samples)
+				{
+					if (samples.empty())
+					{
+						return;
+					}
+
+					std::sort(samples.begin(), samples.end());
+
+					double totalMicroseconds = 0.0;
+					for (double currentSample : samples)
+					{
+						totalMicroseconds += currentSample;
+					}
+					result.meanMicroseconds = totalMicroseconds / static_cast<double>(samples.size());
+					result.p50Microseconds = samples[samples.size() / 2];
+					result.p99Microseconds = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+					result.maxMicroseconds = samples.back();
+				}
+
+				//------------------------------------------------------------------------------
+				// Yields given times, then finishes
+				class BenchmarkYieldTask
+					: public ITask
+				{
+				public:
+					BenchmarkYieldTask(size_t yieldCount) : m_leftYieldCount(yieldCount) { }
+
+				public:
+					virtual TaskDoneResult Do() override
+					{
+						if (m_leftYieldCount == 0)
+						{
+							return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+						}
+						--m_leftYieldCount;
+						return TaskDoneResult(TaskDoneResult::ResultType::kYield);
+					}
+
+				protected:
+					size_t m_leftYieldCount;
+				};
+
+				//------------------------------------------------------------------------------
+				// Sleeps once and records how late it woke up
+				class BenchmarkSleepTask
+					: public ITask
+				{
+				public:
+					BenchmarkSleepTask(SchedulingClock::duration sleepDuration) : m_sleepDuration(sleepDuration), m_isSlept(false), m_overshootMicroseconds(0.0) { }
+
+				public:
+					virtual TaskDoneResult Do() override
+					{
+						if (!m_isSlept)
+						{
+							m_isSlept = true;
+							m_sleepStartTime = BenchmarkClock::now();
+							return TaskDoneResult(TaskDoneResult::ResultType::kSleep, m_sleepDuration);
+						}
+
+						BenchmarkClock::duration sleptDuration = BenchmarkClock::now() - m_sleepStartTime;
+						m_overshootMicroseconds = ToBenchmarkMicroseconds(sleptDuration) - std::chrono::duration<double, std::micro>(m_sleepDuration).count();
+						return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+					}
+
+				public:
+					double GetOvershootMicroseconds() const { return m_overshootMicroseconds; }
+
+				protected:
+					SchedulingClock::duration	m_sleepDuration;
+					bool						m_isSlept;
+					BenchmarkClock::time_point	m_sleepStartTime;
+					double						m_overshootMicroseconds;
+				};
+
+				//------------------------------------------------------------------------------
+				// A link of dependent task chain
+				class BenchmarkChainTask
+					: public DependentTask
+				{
+				public:
+					BenchmarkChainTask(std::shared_ptr<ITask> priorTask) : DependentTask(priorTask) { }
+
+				protected:
+					virtual TaskDoneResult _DoWork() override { return TaskDoneResult(TaskDoneResult::ResultType::kFinished); }
+				};
+
+				//------------------------------------------------------------------------------
+				bool AreAllTasksFinished(const std::vector<std::shared_ptr<ITask> > &tasks)
+				{
+					for (const std::shared_ptr<ITask> &currentTask : tasks)
+					{
+						if (!currentTask->IsFinished())
+						{
+							return false;
+						}
+					}
+					return true;
+				}
+			}
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// Benchmark
+
+		namespace Benchmark
+		{
+			//------------------------------------------------------------------------------
+			// Submit empty tasks in batches and wait all of them
+			TaskBenchmarkResult RunEmptyTaskThroughput(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings)
+			{
+				TaskBenchmarkResult result;
+				result.name = "empty_task_throughput";
+
+				std::shared_ptr<std::atomic<size_t> > doneCount(std::make_shared<std::atomic<size_t> >(0));
+				std::vector<std::shared_ptr<ITask> > batchBuffer;
+				batchBuffer.reserve(_Internal::kBenchmarkSubmitBatchSize);
+
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				for (size_t submittedCount = 0; submittedCount < settings.throughputTaskCount; )
+				{
+					size_t batchSize = std::min(_Internal::kBenchmarkSubmitBatchSize, settings.throughputTaskCount - submittedCount);
+					batchBuffer.clear();
+					for (size_t i = 0; i < batchSize; ++i)
+					{
+						batchBuffer.push_back(PooledActionTask::Create([doneCount]() { doneCount->fetch_add(1, std::memory_order_relaxed); }));
+					}
+					manager.ExecuteTasks(batchBuffer.data(), batchBuffer.size());
+					submittedCount += batchSize;
+				}
+				batchBuffer.clear();
+
+				size_t targetCount = settings.throughputTaskCount;
+				result.isCompleted = _Internal::WaitBenchmarkCondition([doneCount, targetCount]() { return (doneCount->load(std::memory_order_relaxed) >= targetCount); }, settings.caseTimeout);
+				_Internal::FillThroughput(result, doneCount->load(), _Internal::BenchmarkClock::now() - startTime);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Time from a submission to the start of the task, one by one on the idle system
+			TaskBenchmarkResult RunExecutionLatency(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings)
+			{
+				TaskBenchmarkResult result;
+				result.name = "execution_latency";
+				result.isCompleted = true;
+
+				std::shared_ptr<std::atomic<_Internal::BenchmarkClock::rep> > executedTime(std::make_shared<std::atomic<_Internal::BenchmarkClock::rep> >(0));
+				std::vector<double> latencySamples;
+				latencySamples.reserve(settings.latencySampleCount);
+
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				for (size_t i = 0; i < settings.latencySampleCount; ++i)
+				{
+					executedTime->store(0, std::memory_order_relaxed);
+
+					_Internal::BenchmarkClock::time_point submitTime = _Internal::BenchmarkClock::now();
+					manager.ExecuteAction([executedTime]() { executedTime->store(_Internal::BenchmarkClock::now().time_since_epoch().count(), std::memory_order_release); });
+
+					if (!_Internal::WaitBenchmarkCondition([executedTime]() { return (executedTime->load(std::memory_order_acquire) != 0); }, settings.caseTimeout))
+					{
+						result.isCompleted = false;
+						break;
+					}
+
+					_Internal::BenchmarkClock::time_point startedTime{ _Internal::BenchmarkClock::duration(executedTime->load(std::memory_order_acquire)) };
+					latencySamples.push_back(_Internal::ToBenchmarkMicroseconds(startedTime - submitTime));
+				}
+				_Internal::FillThroughput(result, latencySamples.size(), _Internal::BenchmarkClock::now() - startTime);
+				_Internal::FillLatencyDistribution(result, latencySamples);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Cost of a yield, from returning kYield to the next step
+			TaskBenchmarkResult RunYieldRoundTrip(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings)
+			{
+				TaskBenchmarkResult result;
+				result.name = "yield_round_trip";
+
+				std::shared_ptr<ITask> yieldTask(std::make_shared<_Internal::BenchmarkYieldTask>(settings.yieldRoundTripCount));
+
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				manager.ExecuteTask(yieldTask);
+				result.isCompleted = _Internal::WaitBenchmarkCondition([&yieldTask]() { return yieldTask->IsFinished(); }, settings.caseTimeout);
+				_Internal::FillThroughput(result, settings.yieldRoundTripCount, _Internal::BenchmarkClock::now() - startTime);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Wake-up lateness of concurrently sleeping tasks; latency distribution is of the overshoot
+			TaskBenchmarkResult RunSleepAccuracy(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings, SchedulingClock::duration sleepDuration)
+			{
+				TaskBenchmarkResult result;
+				result.name = "sleep_accuracy";
+
+				char variantBuffer[32];
+				snprintf(variantBuffer, sizeof(variantBuffer), "%lldus", static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(sleepDuration).count()));
+				result.variant = variantBuffer;
+
+				std::vector<std::shared_ptr<_Internal::BenchmarkSleepTask> > sleepTasks;
+				std::vector<std::shared_ptr<ITask> > submittingTasks;
+				sleepTasks.reserve(settings.sleepSampleCount);
+				submittingTasks.reserve(settings.sleepSampleCount);
+				for (size_t i = 0; i < settings.sleepSampleCount; ++i)
+				{
+					sleepTasks.push_back(std::make_shared<_Internal::BenchmarkSleepTask>(sleepDuration));
+					submittingTasks.push_back(sleepTasks.back());
+				}
+
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				manager.ExecuteTasks(submittingTasks.data(), submittingTasks.size());
+				result.isCompleted = _Internal::WaitBenchmarkCondition([&submittingTasks]() { return _Internal::AreAllTasksFinished(submittingTasks); }, settings.caseTimeout + sleepDuration);
+				_Internal::FillThroughput(result, settings.sleepSampleCount, _Internal::BenchmarkClock::now() - startTime);
+
+				std::vector<double> overshootSamples;
+				overshootSamples.reserve(sleepTasks.size());
+				for (const std::shared_ptr<_Internal::BenchmarkSleepTask> &currentTask : sleepTasks)
+				{
+					if (currentTask->IsFinished() && !currentTask->HasError())
+					{
+						overshootSamples.push_back(currentTask->GetOvershootMicroseconds());
+					}
+				}
+				_Internal::FillLatencyDistribution(result, overshootSamples);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Time for a finish to propagate through a chain of dependent tasks, per link
+			TaskBenchmarkResult RunDependentChainLatency(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings)
+			{
+				TaskBenchmarkResult result;
+				result.name = "dependent_chain_latency";
+
+				if (settings.dependentChainLength == 0)
+				{
+					return result;
+				}
+
+				// Head of the chain is executed after every link parked
+				std::shared_ptr<ITask> headTask(PooledActionTask::Create([]() { }));
+				std::vector<std::shared_ptr<ITask> > chainTasks;
+				chainTasks.reserve(settings.dependentChainLength);
+				for (size_t i = 0; i < settings.dependentChainLength; ++i)
+				{
+					chainTasks.push_back(std::make_shared<_Internal::BenchmarkChainTask>(chainTasks.empty() ? headTask : chainTasks.back()));
+				}
+				manager.ExecuteTasks(chainTasks.data(), chainTasks.size());
+
+				std::shared_ptr<ITask> &lastTask = chainTasks.back();
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				manager.ExecuteTask(headTask);
+				result.isCompleted = _Internal::WaitBenchmarkCondition([&lastTask]() { return lastTask->IsFinished(); }, settings.caseTimeout);
+				_Internal::FillThroughput(result, settings.dependentChainLength, _Internal::BenchmarkClock::now() - startTime);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Throughput of empty tasks submitted by producer threads at the same time
+			TaskBenchmarkResult RunProducerContention(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings, int producerThreadCount)
+			{
+				TaskBenchmarkResult result;
+				result.name = "producer_contention";
+				result.variant = std::to_string(producerThreadCount) + "_producers";
+
+				if (producerThreadCount < 1)
+				{
+					return result;
+				}
+
+				std::shared_ptr<std::atomic<size_t> > doneCount(std::make_shared<std::atomic<size_t> >(0));
+				std::atomic_bool isStarted(false);
+				size_t tasksPerProducer = settings.tasksPerProducer;
+
+				std::vector<std::thread> producerThreads;
+				producerThreads.reserve(producerThreadCount);
+				for (int i = 0; i < producerThreadCount; ++i)
+				{
+					producerThreads.emplace_back([&manager, &isStarted, doneCount, tasksPerProducer]() {
+						while (!isStarted.load(std::memory_order_acquire))
+						{
+							std::this_thread::yield();
+						}
+						for (size_t j = 0; j < tasksPerProducer; ++j)
+						{
+							manager.ExecuteAction([doneCount]() { doneCount->fetch_add(1, std::memory_order_relaxed); });
+						}
+					});
+				}
+
+				_Internal::BenchmarkClock::time_point startTime = _Internal::BenchmarkClock::now();
+				isStarted.store(true, std::memory_order_release);
+				for (std::thread &currentThread : producerThreads)
+				{
+					currentThread.join();
+				}
+
+				size_t targetCount = tasksPerProducer * static_cast<size_t>(producerThreadCount);
+				result.isCompleted = _Internal::WaitBenchmarkCondition([doneCount, targetCount]() { return (doneCount->load(std::memory_order_relaxed) >= targetCount); }, settings.caseTimeout);
+				_Internal::FillThroughput(result, doneCount->load(), _Internal::BenchmarkClock::now() - startTime);
+
+				return result;
+			}
+
+			//------------------------------------------------------------------------------
+			// Run every case with every variant in the settings
+			std::vector<TaskBenchmarkResult> RunAll(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings)
+			{
+				std::vector<TaskBenchmarkResult> results;
+
+				results.push_back(RunEmptyTaskThroughput(manager, settings));
+				results.push_back(RunExecutionLatency(manager, settings));
+				results.push_back(RunYieldRoundTrip(manager, settings));
+				for (SchedulingClock::duration currentDuration : settings.sleepDurations)
+				{
+					results.push_back(RunSleepAccuracy(manager, settings, currentDuration));
+				}
+				results.push_back(RunDependentChainLatency(manager, settings));
+				for (int currentProducerCount : settings.producerThreadCounts)
+				{
+					results.push_back(RunProducerContention(manager, settings, currentProducerCount));
+				}
+
+				return results;
+			}
+
+			//------------------------------------------------------------------------------
+			// Machine readable output to track regressions
+			std::string ToJSON(const std::vector<TaskBenchmarkResult> &results)
+			{
+				std::string resultString;
+				char lineBuffer[512];
+
+				snprintf(lineBuffer, sizeof(lineBuffer), "{\"suite\":\"LeggieroTask\",\"hardwareConcurrency\":%u,\"results\":[", std::thread::hardware_concurrency());
+				resultString.append(lineBuffer);
+
+				for (size_t i = 0; i < results.size(); ++i)
+				{
+					const TaskBenchmarkResult &currentResult = results[i];
+					snprintf(lineBuffer, sizeof(lineBuffer),
+						"%s\n{\"name\":\"%s\",\"variant\":\"%s\",\"completed\":%s,\"operations\":%llu,\"elapsedUs\":%.3f,\"nsPerOp\":%.3f,\"opsPerSec\":%.3f,\"meanUs\":%.3f,\"p50Us\":%.3f,\"p99Us\":%.3f,\"maxUs\":%.3f}",
+						((i == 0) ? "" : ","), currentResult.name.c_str(), currentResult.variant.c_str(), (currentResult.isCompleted ? "true" : "false"),
+						static_cast<unsigned long long>(currentResult.operationCount), currentResult.elapsedMicroseconds, currentResult.nanosecondsPerOperation, currentResult.operationsPerSecond,
+						currentResult.meanMicroseconds, currentResult.p50Microseconds, currentResult.p99Microseconds, currentResult.maxMicroseconds);
+					resultString.append(lineBuffer);
+				}
+
+				resultString.append("\n]}\n");
+				return resultString;
+			}
+		}
+	}
+}
@@ -0,0 +1,104 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// TaskBenchmark.h (Leggiero/Modules - Task)
+//
+// Micro-benchmarks of the task system
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASK_BENCHMARK_H
+#define __LM_TASK__TASK_BENCHMARK_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Leggiero.Task
+#include "TaskTypes.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		// Forward Declaration
+		class TaskManagerComponent;
+
+
+		// Result of a benchmark case
+		struct TaskBenchmarkResult
+		{
+		public:
+			std::string	name;
+			std::string	variant;
+
+			bool		isCompleted;
+
+			uint64_t	operationCount;
+			double		elapsedMicroseconds;
+			double		nanosecondsPerOperation;
+			double		operationsPerSecond;
+
+			// Per-operation latency distribution; zero for throughput-only cases
+			double		meanMicroseconds;
+			double		p50Microseconds;
+			double		p99Microseconds;
+			double		maxMicroseconds;
+
+		public:
+			TaskBenchmarkResult()
+				: isCompleted(false), operationCount(0), elapsedMicroseconds(0.0), nanosecondsPerOperation(0.0), operationsPerSecond(0.0)
+				, meanMicroseconds(0.0), p50Microseconds(0.0), p99Microseconds(0.0), maxMicroseconds(0.0)
+			{ }
+		};
+
+
+		// Sizes of benchmark cases
+		struct TaskBenchmarkSettings
+		{
+		public:
+			size_t throughputTaskCount = 100000;
+			size_t latencySampleCount = 2000;
+			size_t yieldRoundTripCount = 100000;
+
+			std::vector<SchedulingClock::duration> sleepDurations = { std::chrono::milliseconds(1), std::chrono::milliseconds(4), std::chrono::milliseconds(16), std::chrono::milliseconds(100), std::chrono::milliseconds(500) };
+			size_t sleepSampleCount = 64;
+
+			size_t dependentChainLength = 1000;
+
+			std::vector<int> producerThreadCounts = { 1, 2, 4, 8 };
+			size_t tasksPerProducer = 20000;
+
+			// A case not finished in this time is reported as not completed
+			std::chrono::steady_clock::duration caseTimeout = std::chrono::seconds(30);
+		};
+
+
+		namespace Benchmark
+		{
+			// Each case blocks the calling thread until its tasks finish, so should be run by a manager with worker threads
+			// from a thread other than the game thread (e.g. a debug menu task or a dedicated thread).
+			// Run on an otherwise idle task system; other tasks disturb the numbers.
+
+			TaskBenchmarkResult RunEmptyTaskThroughput(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings);
+			TaskBenchmarkResult RunExecutionLatency(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings);
+			TaskBenchmarkResult RunYieldRoundTrip(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings);
+			TaskBenchmarkResult RunSleepAccuracy(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings, SchedulingClock::duration sleepDuration);
+			TaskBenchmarkResult RunDependentChainLatency(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings);
+			TaskBenchmarkResult RunProducerContention(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings, int producerThreadCount);
+
+			// Run every case with every variant in the settings
+			std::vector<TaskBenchmarkResult> RunAll(TaskManagerComponent &manager, const TaskBenchmarkSettings &settings = TaskBenchmarkSettings());
+
+			// Machine readable output to track regressions
+			std::string ToJSON(const std::vector<TaskBenchmarkResult> &results);
+		}
+	}
+}
+
+#endif
@@ -7,6 +7,13 @@
 // My Header
 #include "TaskManagerComponent.h"
 
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+
 
 DEFINE_GET_COMPONENT_INTERFACE(Leggiero::Task::TaskManagerComponent, Leggiero::EngineComponentIdType::kTaskManager);
 
@@ -15,6 +22,95 @@ namespace Leggiero
 {
 	namespace Task
 	{
+		//////////////////////////////////////////////////////////////////////////////// Parallel For Internal Implementation
+
+		namespace _Internal
+		{
+			namespace
+			{
+				// Chunk cost aimed by grain size adaptation
+				constexpr std::chrono::steady_clock::duration kTargetChunkDuration = std::chrono::microseconds(500);
+
+				// Chunks per participant at least, for load balancing
+				constexpr size_t kMinChunkPerParticipant = 4;
+
+				// Used when the hardware concurrency is unknown
+				constexpr size_t kDefaultParticipantCount = 4;
+
+				struct ParallelForContext
+				{
+				public:
+					std::atomic<size_t>	nextIndex;
+					std::atomic<size_t>	grainSize;
+					std::atomic<size_t>	doneCount;
+
+					size_t rangeEnd;
+					size_t minGrainSize;
+					size_t maxGrainSize;
+
+					// Valid only while the calling thread is waiting for chunks
+					const std::function<void(size_t, size_t, size_t)> *chunkFunc;
+
+					// First exception from chunks; read by the calling thread after all chunks done
+					std::atomic_bool	isFailed;
+					std::exception_ptr	exception;
+				};
+
+				//------------------------------------------------------------------------------
+				// Process chunks until the range exhausted
+				void ParticipateParallelFor(ParallelForContext &context, size_t participantIndex)
+				{
+					while (true)
+					{
+						size_t currentGrainSize = context.grainSize.load(std::memory_order_relaxed);
+						size_t chunkBegin = context.nextIndex.fetch_add(currentGrainSize, std::memory_order_relaxed);
+						if (chunkBegin >= context.rangeEnd)
+						{
+							break;
+						}
+						size_t chunkEnd = ((context.rangeEnd - chunkBegin > currentGrainSize) ? (chunkBegin + currentGrainSize) : context.rangeEnd);
+
+						if (context.isFailed.load(std::memory_order_relaxed))
+						{
+							// Skip left chunks after a failure, but count them done to be joined
+							context.doneCount.fetch_add(chunkEnd - chunkBegin, std::memory_order_release);
+							continue;
+						}
+
+						std::chrono::steady_clock::time_point chunkStartTime = std::chrono::steady_clock::now();
+						try
+						{
+							(*context.chunkFunc)(chunkBegin, chunkEnd, participantIndex);
+						}
+						catch (...)
+						{
+							if (!context.isFailed.exchange(true))
+							{
+								context.exception = std::current_exception();
+							}
+						}
+						std::chrono::steady_clock::duration chunkDuration = std::chrono::steady_clock::now() - chunkStartTime;
+
+						// Adapt grain size to the measured cost
+						if (chunkEnd - chunkBegin == currentGrainSize)
+						{
+							if (chunkDuration < kTargetChunkDuration / 4 && currentGrainSize < context.maxGrainSize)
+							{
+								context.grainSize.compare_exchange_weak(currentGrainSize, std::min(currentGrainSize * 2, context.maxGrainSize), std::memory_order_relaxed);
+							}
+							else if (chunkDuration > kTargetChunkDuration * 2 && currentGrainSize > context.minGrainSize)
+							{
+								context.grainSize.compare_exchange_weak(currentGrainSize, std::max(currentGrainSize / 2, context.minGrainSize), std::memory_order_relaxed);
+							}
+						}
+
+						context.doneCount.fetch_add(chunkEnd - chunkBegin, std::memory_order_release);
+					}
+				}
+			}
+		}
+
+
 		//////////////////////////////////////////////////////////////////////////////// TaskManagerComponent
 
 		//------------------------------------------------------------------------------
@@ -26,5 +122,98 @@ namespace Leggiero
 		TaskManagerComponent::~TaskManagerComponent()
 		{
 		}
+
+		//------------------------------------------------------------------------------
+		// Process [rangeBegin, rangeEnd) by chunks on general workers and the calling thread, and return after all chunks done
+		void TaskManagerComponent::ParallelFor(size_t rangeBegin, size_t rangeEnd, size_t grainSize, const std::function<void(size_t chunkBegin, size_t chunkEnd)> &chunkFunc,
+			TaskPriorityClass priority)
+		{
+			if (!chunkFunc)
+			{
+				return;
+			}
+
+			_ParallelForParticipants(rangeBegin, rangeEnd, grainSize, _GetParallelParticipantCount(rangeBegin, rangeEnd, grainSize),
+				[&chunkFunc](size_t chunkBegin, size_t chunkEnd, size_t /*participantIndex*/) { chunkFunc(chunkBegin, chunkEnd); }, priority);
+		}
+
+		//------------------------------------------------------------------------------
+		size_t TaskManagerComponent::_GetParallelParticipantCount(size_t rangeBegin, size_t rangeEnd, size_t grainSize)
+		{
+			if (rangeEnd <= rangeBegin)
+			{
+				return 1;
+			}
+			if (grainSize == 0)
+			{
+				grainSize = 1;
+			}
+
+			size_t chunkCount = (rangeEnd - rangeBegin - 1) / grainSize + 1;
+			size_t hardwareConcurrency = static_cast<size_t>(std::thread::hardware_concurrency());
+			if (hardwareConcurrency == 0)
+			{
+				hardwareConcurrency = _Internal::kDefaultParticipantCount;
+			}
+
+			return std::max(static_cast<size_t>(1), std::min(chunkCount, hardwareConcurrency));
+		}
+
+		//------------------------------------------------------------------------------
+		void TaskManagerComponent::_ParallelForParticipants(size_t rangeBegin, size_t rangeEnd, size_t grainSize, size_t participantCount,
+			const std::function<void(size_t chunkBegin, size_t chunkEnd, size_t participantIndex)> &chunkFunc, TaskPriorityClass priority)
+		{
+			if (rangeEnd <= rangeBegin)
+			{
+				return;
+			}
+			if (grainSize == 0)
+			{
+				grainSize = 1;
+			}
+
+			if (participantCount <= 1)
+			{
+				// Nothing to share
+				chunkFunc(rangeBegin, rangeEnd, 0);
+				return;
+			}
+
+			const size_t rangeSize = rangeEnd - rangeBegin;
+			std::shared_ptr<_Internal::ParallelForContext> context(std::make_shared<_Internal::ParallelForContext>());
+			context->nextIndex.store(rangeBegin, std::memory_order_relaxed);
+			context->grainSize.store(grainSize, std::memory_order_relaxed);
+			context->doneCount.store(0, std::memory_order_relaxed);
+			context->rangeEnd = rangeEnd;
+			context->minGrainSize = grainSize;
+			context->maxGrainSize = std::max(grainSize, rangeSize / (participantCount * _Internal::kMinChunkPerParticipant));
+			context->chunkFunc = &chunkFunc;
+			context->isFailed.store(false, std::memory_order_relaxed);
+
+			// Helpers started after the range exhausted finish without any work
+			std::vector<std::shared_ptr<ITask> > helperTasks;
+			helperTasks.reserve(participantCount - 1);
+			for (size_t i = 1; i < participantCount; ++i)
+			{
+				helperTasks.push_back(PooledActionTask::Create([context, i]() { _Internal::ParticipateParallelFor(*context, i); }, TaskCapabilities::kGeneral, priority));
+			}
+			ExecuteTasks(helperTasks.data(), helperTasks.size());
+
+			// Calling thread also processes chunks, so progress is guaranteed even with no free worker
+			_Internal::ParticipateParallelFor(*context, 0);
+
+			// Join chunks in processing by other participants
+			while (context->doneCount.load(std::memory_order_acquire) < rangeSize)
+			{
+				std::this_thread::yield();
+			}
+
+			if (context->isFailed.load())
+			{
+				// Taken out of the context, which can be released later by a helper
+				std::exception_ptr chunkException(std::move(context->exception));
+				std::rethrow_exception(chunkException);
+			}
+		}
 	}
 }
@@ -12,7 +12,12 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standard Library
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Leggiero.Engine
 #include <Engine/Module/EngineComponent.h>
@@ -20,6 +25,8 @@
 
 // Leggiero.Task
 #include "TaskTypes.h"
+#include "TaskTelemetry.h"
+#include "Tasks/PooledActionTask.h"
 #include "_Internal/ITaskManagerSystemFunctions.h"
 
 
@@ -32,6 +39,13 @@ namespace Leggiero
 		class ITaskProcessor;
 
 
+		namespace _Internal
+		{
+			// Alignment of per-participant data of parallel helpers, not to share a cache line between participants
+			constexpr size_t kParallelParticipantSlotAlignment = 64;
+		}
+
+
 		// Task Manager Component
 		class TaskManagerComponent
 			: public EngineComponent
@@ -50,6 +64,78 @@ namespace Leggiero
 
 		public:
 			virtual bool ExecuteTask(std::shared_ptr<ITask> task) = 0;
+
+			// Execute tasks at once, with fewer queue operations and worker wake-ups than executing one by one
+			// Returns count of accepted tasks.
+			virtual size_t ExecuteTasks(const std::shared_ptr<ITask> *tasks, size_t taskCount) = 0;
+
+			template <typename TaskT>
+			size_t ExecuteTasks(const std::vector<std::shared_ptr<TaskT> > &tasks)
+			{
+				if constexpr (std::is_same<TaskT, ITask>::value)
+				{
+					return ExecuteTasks(tasks.data(), tasks.size());
+				}
+				else
+				{
+					std::vector<std::shared_ptr<ITask> > convertedTasks(tasks.begin(), tasks.end());
+					return ExecuteTasks(convertedTasks.data(), convertedTasks.size());
+				}
+			}
+
+			// Execute a fire-and-forget action as a pooled task, without heap allocation for small actions
+			template <typename ActionT>
+			bool ExecuteAction(ActionT &&action, TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault)
+			{
+				return ExecuteTask(PooledActionTask::Create(std::forward<ActionT>(action), capabilities, priority));
+			}
+
+		public:	// Telemetry
+			// Collect current telemetry of the task system; can be polled in the game loop
+			virtual void GetTelemetrySnapshot(TaskTelemetrySnapshot &outSnapshot) = 0;
+
+		public:	// Data Parallel Helpers
+			// Process [rangeBegin, rangeEnd) by chunks on general workers and the calling thread, and return after all chunks done
+			// Chunk size starts from grainSize and adapts to the measured chunk cost, never smaller than grainSize.
+			// If chunkFunc throws, left chunks are skipped and the first exception is rethrown after all participants are done.
+			void ParallelFor(size_t rangeBegin, size_t rangeEnd, size_t grainSize, const std::function<void(size_t chunkBegin, size_t chunkEnd)> &chunkFunc,
+				TaskPriorityClass priority = TaskPriorityClass::kDefault);
+
+			// Reduce [rangeBegin, rangeEnd) in parallel; chunkFunc(chunkBegin, chunkEnd) gives a partial value, and reduceFunc(a, b) combines them
+			// reduceFunc should be associative and commutative, and identity should be its identity element.
+			template <typename ValueT, typename ChunkFuncT, typename ReduceFuncT>
+			ValueT ParallelReduce(size_t rangeBegin, size_t rangeEnd, size_t grainSize, ValueT identity, ChunkFuncT &&chunkFunc, ReduceFuncT &&reduceFunc,
+				TaskPriorityClass priority = TaskPriorityClass::kDefault)
+			{
+				// Each participant writes its own slot only
+				struct alignas(_Internal::kParallelParticipantSlotAlignment) PartialSlot
+				{
+				public:
+					ValueT value;
+				};
+
+				const size_t participantCount = _GetParallelParticipantCount(rangeBegin, rangeEnd, grainSize);
+				std::vector<PartialSlot> partialValues(participantCount, PartialSlot{ identity });
+
+				_ParallelForParticipants(rangeBegin, rangeEnd, grainSize, participantCount,
+					[&partialValues, &chunkFunc, &reduceFunc](size_t chunkBegin, size_t chunkEnd, size_t participantIndex)
+					{
+						ValueT &partialValue = partialValues[participantIndex].value;
+						partialValue = reduceFunc(std::move(partialValue), chunkFunc(chunkBegin, chunkEnd));
+					}, priority);
+
+				ValueT resultValue = std::move(identity);
+				for (PartialSlot &currentPartial : partialValues)
+				{
+					resultValue = reduceFunc(std::move(resultValue), std::move(currentPartial.value));
+				}
+				return resultValue;
+			}
+
+		protected:
+			size_t _GetParallelParticipantCount(size_t rangeBegin, size_t rangeEnd, size_t grainSize);
+			void _ParallelForParticipants(size_t rangeBegin, size_t rangeEnd, size_t grainSize, size_t participantCount,
+				const std::function<void(size_t chunkBegin, size_t chunkEnd, size_t participantIndex)> &chunkFunc, TaskPriorityClass priority);
 		};
 	}
 }
@@ -0,0 +1,293 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// TaskTelemetry.cpp (Leggiero/Modules - Task)
+//
+// Task system telemetry implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "TaskTelemetry.h"
+
+// Standard Library
+#include <cstdio>
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+		namespace _Internal
+		{
+			namespace
+			{
+				//------------------------------------------------------------------------------
+				struct TelemetryHistogram
+				{
+				public:
+					std::atomic<uint64_t> count;
+					std::atomic<uint64_t> totalMicroseconds;
+					std::atomic<uint64_t> buckets[TaskTelemetrySnapshot::kLatencyBucketCount];
+
+				public:
+					TelemetryHistogram() { Reset(); }
+
+				public:
+					void Record(uint64_t microseconds)
+					{
+						int bucketIndex = 0;
+						while (bucketIndex < TaskTelemetrySnapshot::kLatencyBucketCount - 1 && (microseconds >> (bucketIndex + 1)) != 0)
+						{
+							++bucketIndex;
+						}
+
+						count.fetch_add(1, std::memory_order_relaxed);
+						totalMicroseconds.fetch_add(microseconds, std::memory_order_relaxed);
+						buckets[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+					}
+
+					void Fill(TaskTelemetrySnapshot::Histogram &outHistogram) const
+					{
+						outHistogram.count = count.load(std::memory_order_relaxed);
+						outHistogram.totalMicroseconds = totalMicroseconds.load(std::memory_order_relaxed);
+						for (int i = 0; i < TaskTelemetrySnapshot::kLatencyBucketCount; ++i)
+						{
+							outHistogram.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+						}
+					}
+
+					void Reset()
+					{
+						count.store(0, std::memory_order_relaxed);
+						totalMicroseconds.store(0, std::memory_order_relaxed);
+						for (int i = 0; i < TaskTelemetrySnapshot::kLatencyBucketCount; ++i)
+						{
+							buckets[i].store(0, std::memory_order_relaxed);
+						}
+					}
+				};
+
+				//------------------------------------------------------------------------------
+				struct TaskTypeTelemetry
+				{
+				public:
+					std::atomic<const std::type_info *> taskType;
+
+					TelemetryHistogram startLatency;
+					TelemetryHistogram stepDuration;
+
+					std::atomic<uint64_t> finishCount;
+					std::atomic<uint64_t> yieldCount;
+					std::atomic<uint64_t> sleepCount;
+					std::atomic<uint64_t> waitConditionCount;
+
+				public:
+					TaskTypeTelemetry()
+						: taskType(nullptr)
+					{
+						ResetCounts();
+					}
+
+				public:
+					void ResetCounts()
+					{
+						startLatency.Reset();
+						stepDuration.Reset();
+						finishCount.store(0, std::memory_order_relaxed);
+						yieldCount.store(0, std::memory_order_relaxed);
+						sleepCount.store(0, std::memory_order_relaxed);
+						waitConditionCount.store(0, std::memory_order_relaxed);
+					}
+				};
+
+				// Lock-free open addressing table by task type; types over the capacity are not recorded
+				constexpr size_t kMaxTaskTypeCount = 128;
+
+				std::atomic_bool	g_isTelemetryEnabled(true);
+				TaskTypeTelemetry	g_taskTypeTable[kMaxTaskTypeCount];
+
+				//------------------------------------------------------------------------------
+				TaskTypeTelemetry *FindTaskTypeTelemetry(const std::type_info &taskType)
+				{
+					size_t startIndex = taskType.hash_code() % kMaxTaskTypeCount;
+					for (size_t i = 0; i < kMaxTaskTypeCount; ++i)
+					{
+						TaskTypeTelemetry &currentEntry = g_taskTypeTable[(startIndex + i) % kMaxTaskTypeCount];
+						const std::type_info *entryType = currentEntry.taskType.load(std::memory_order_acquire);
+						if (entryType == nullptr)
+						{
+							if (currentEntry.taskType.compare_exchange_strong(entryType, &taskType, std::memory_order_acq_rel))
+							{
+								return &currentEntry;
+							}
+						}
+						if (entryType == &taskType || (entryType != nullptr && *entryType == taskType))
+						{
+							return &currentEntry;
+						}
+					}
+					return nullptr;
+				}
+			}
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// TaskTelemetrySnapshot
+
+		//------------------------------------------------------------------------------
+		// Upper bound of the bucket containing the given percentile (0.0 ~ 1.0)
+		uint64_t TaskTelemetrySnapshot::Histogram::GetPercentileUpperBoundMicroseconds(double percentile) const
+		{
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			uint64_t targetCount = static_cast<uint64_t>(static_cast<double>(count) * percentile);
+			if (targetCount == 0)
+			{
+				targetCount = 1;
+			}
+
+			uint64_t accumulatedCount = 0;
+			for (int i = 0; i < kLatencyBucketCount; ++i)
+			{
+				accumulatedCount += buckets[i];
+				if (accumulatedCount >= targetCount)
+				{
+					return (static_cast<uint64_t>(1) << (i + 1));
+				}
+			}
+			return (static_cast<uint64_t>(1) << kLatencyBucketCount);
+		}
+
+		//------------------------------------------------------------------------------
+		// Human readable dump for logging
+		std::string TaskTelemetrySnapshot::ToString() const
+		{
+			std::string resultString;
+			char lineBuffer[512];
+
+			snprintf(lineBuffer, sizeof(lineBuffer), "[Task Telemetry] condition waiting(rt/short/long): %zu/%zu/%zu, timer waiting: %zu\n",
+				conditionWaitingRealtimeDepth, conditionWaitingShortTermDepth, conditionWaitingLongTermDepth, timerWaitingDepth);
+			resultString.append(lineBuffer);
+
+			for (const ProcessorEntry &currentProcessor : processors)
+			{
+				snprintf(lineBuffer, sizeof(lineBuffer), "  processor(cap 0x%x): queue %zu, workers %zu\n",
+					static_cast<unsigned int>(currentProcessor.capability), currentProcessor.queueDepth, currentProcessor.workers.size());
+				resultString.append(lineBuffer);
+
+				for (size_t i = 0; i < currentProcessor.workers.size(); ++i)
+				{
+					snprintf(lineBuffer, sizeof(lineBuffer), "    worker %zu: busy %.1f%%\n", i, currentProcessor.workers[i].GetBusyRatio() * 100.0);
+					resultString.append(lineBuffer);
+				}
+			}
+
+			if (!isInstrumented)
+			{
+				resultString.append("  (task instrumentation disabled)\n");
+				return resultString;
+			}
+
+			for (const TaskTypeEntry &currentType : taskTypes)
+			{
+				snprintf(lineBuffer, sizeof(lineBuffer), "  %s: steps %llu, finished %llu, yield %llu, sleep %llu, wait %llu, start latency avg %.1fus p99<%lluus, step avg %.1fus p99<%lluus\n",
+					currentType.typeName.c_str(), static_cast<unsigned long long>(currentType.stepDuration.count), static_cast<unsigned long long>(currentType.finishCount),
+					static_cast<unsigned long long>(currentType.yieldCount), static_cast<unsigned long long>(currentType.sleepCount), static_cast<unsigned long long>(currentType.waitConditionCount),
+					currentType.startLatency.GetAverageMicroseconds(), static_cast<unsigned long long>(currentType.startLatency.GetPercentileUpperBoundMicroseconds(0.99)),
+					currentType.stepDuration.GetAverageMicroseconds(), static_cast<unsigned long long>(currentType.stepDuration.GetPercentileUpperBoundMicroseconds(0.99)));
+				resultString.append(lineBuffer);
+			}
+
+			return resultString;
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// Telemetry
+
+		namespace Telemetry
+		{
+			//------------------------------------------------------------------------------
+			bool IsEnabled()
+			{
+				#if _LEGGIERO_TASK_TELEMETRY
+					return _Internal::g_isTelemetryEnabled.load(std::memory_order_relaxed);
+				#else
+					return false;
+				#endif
+			}
+
+			//------------------------------------------------------------------------------
+			void SetEnabled(bool isEnabled)
+			{
+				_Internal::g_isTelemetryEnabled.store(isEnabled, std::memory_order_relaxed);
+			}
+
+			//------------------------------------------------------------------------------
+			// Reset all task type statistics
+			void Reset()
+			{
+				for (size_t i = 0; i < _Internal::kMaxTaskTypeCount; ++i)
+				{
+					_Internal::g_taskTypeTable[i].ResetCounts();
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			// Record a processed step of a task
+			void RecordTaskStep(const std::type_info &taskType, TelemetryClock::duration startLatency, TelemetryClock::duration stepDuration, TaskDoneResult::ResultType stepResult)
+			{
+				_Internal::TaskTypeTelemetry *typeTelemetry = _Internal::FindTaskTypeTelemetry(taskType);
+				if (typeTelemetry == nullptr)
+				{
+					return;
+				}
+
+				typeTelemetry->startLatency.Record(ToMicroseconds(startLatency));
+				typeTelemetry->stepDuration.Record(ToMicroseconds(stepDuration));
+
+				switch (stepResult)
+				{
+					case TaskDoneResult::ResultType::kFinished: typeTelemetry->finishCount.fetch_add(1, std::memory_order_relaxed); break;
+					case TaskDoneResult::ResultType::kYield: typeTelemetry->yieldCount.fetch_add(1, std::memory_order_relaxed); break;
+					case TaskDoneResult::ResultType::kSleep: typeTelemetry->sleepCount.fetch_add(1, std::memory_order_relaxed); break;
+					case TaskDoneResult::ResultType::kWaitCondition: typeTelemetry->waitConditionCount.fetch_add(1, std::memory_order_relaxed); break;
+				}
+			}
+
+			//------------------------------------------------------------------------------
+			// Fill task type statistics of the snapshot
+			void FillTaskTypeSnapshot(TaskTelemetrySnapshot &outSnapshot)
+			{
+				outSnapshot.isInstrumented = IsEnabled();
+				outSnapshot.taskTypes.clear();
+				if (!outSnapshot.isInstrumented)
+				{
+					return;
+				}
+
+				for (size_t i = 0; i < _Internal::kMaxTaskTypeCount; ++i)
+				{
+					const _Internal::TaskTypeTelemetry &currentEntry = _Internal::g_taskTypeTable[i];
+					const std::type_info *entryType = currentEntry.taskType.load(std::memory_order_acquire);
+					if (entryType == nullptr)
+					{
+						continue;
+					}
+
+					outSnapshot.taskTypes.emplace_back();
+					TaskTelemetrySnapshot::TaskTypeEntry &filling = outSnapshot.taskTypes.back();
+					filling.typeName = entryType->name();
+					currentEntry.startLatency.Fill(filling.startLatency);
+					currentEntry.stepDuration.Fill(filling.stepDuration);
+					filling.finishCount = currentEntry.finishCount.load(std::memory_order_relaxed);
+					filling.yieldCount = currentEntry.yieldCount.load(std::memory_order_relaxed);
+					filling.sleepCount = currentEntry.sleepCount.load(std::memory_order_relaxed);
+					filling.waitConditionCount = currentEntry.waitConditionCount.load(std::memory_order_relaxed);
+				}
+			}
+		}
+	}
+}
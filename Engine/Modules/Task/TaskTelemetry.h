@@ -0,0 +1,147 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// TaskTelemetry.h (Leggiero/Modules - Task)
+//
+// Lightweight counters and histograms of the task system
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASK_TELEMETRY_H
+#define __LM_TASK__TASK_TELEMETRY_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+// Leggiero.Task
+#include "TaskTypes.h"
+
+
+// Telemetry instrumentation is compiled in debug builds by default
+// Define _LEGGIERO_TASK_TELEMETRY as 1 or 0 to force it on or off.
+#ifndef _LEGGIERO_TASK_TELEMETRY
+	#ifdef _LEGGIERO_DEBUG
+		#define _LEGGIERO_TASK_TELEMETRY 1
+	#else
+		#define _LEGGIERO_TASK_TELEMETRY 0
+	#endif
+#endif
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		// Clock for telemetry measurement
+		using TelemetryClock = std::chrono::steady_clock;
+
+
+		// Snapshot of the task system telemetry
+		struct TaskTelemetrySnapshot
+		{
+		public:
+			// Bucket i counts values in [2^i, 2^(i+1)) microseconds; bucket 0 also counts values under 1us
+			static constexpr int kLatencyBucketCount = 24;
+
+			struct Histogram
+			{
+			public:
+				uint64_t count;
+				uint64_t totalMicroseconds;
+				uint64_t buckets[kLatencyBucketCount];
+
+			public:
+				double GetAverageMicroseconds() const { return ((count > 0) ? (static_cast<double>(totalMicroseconds) / static_cast<double>(count)) : 0.0); }
+
+				// Upper bound of the bucket containing the given percentile (0.0 ~ 1.0)
+				uint64_t GetPercentileUpperBoundMicroseconds(double percentile) const;
+			};
+
+			struct TaskTypeEntry
+			{
+			public:
+				std::string typeName;
+
+				Histogram	startLatency;	// from enqueued to a processor until the step starts
+				Histogram	stepDuration;	// duration of a Do() call
+
+				uint64_t	finishCount;
+				uint64_t	yieldCount;
+				uint64_t	sleepCount;
+				uint64_t	waitConditionCount;
+			};
+
+			struct WorkerEntry
+			{
+			public:
+				uint64_t busyMicroseconds;
+				uint64_t aliveMicroseconds;
+
+			public:
+				double GetBusyRatio() const { return ((aliveMicroseconds > 0) ? (static_cast<double>(busyMicroseconds) / static_cast<double>(aliveMicroseconds)) : 0.0); }
+			};
+
+			struct ProcessorEntry
+			{
+			public:
+				TaskCapabilityType			capability;
+				size_t						queueDepth;
+				std::vector<WorkerEntry>	workers;
+			};
+
+		public:
+			bool isInstrumented;	// false if the instrumentation is compiled out or disabled
+
+			std::vector<ProcessorEntry> processors;
+
+			size_t conditionWaitingRealtimeDepth;
+			size_t conditionWaitingShortTermDepth;
+			size_t conditionWaitingLongTermDepth;
+			size_t timerWaitingDepth;
+
+			std::vector<TaskTypeEntry> taskTypes;
+
+		public:
+			TaskTelemetrySnapshot()
+				: isInstrumented(false)
+				, conditionWaitingRealtimeDepth(0), conditionWaitingShortTermDepth(0), conditionWaitingLongTermDepth(0), timerWaitingDepth(0)
+			{ }
+
+		public:
+			// Human readable dump for logging
+			std::string ToString() const;
+		};
+
+
+		namespace Telemetry
+		{
+			// Runtime switch of the instrumentation; only a relaxed load when disabled
+			bool IsEnabled();
+			void SetEnabled(bool isEnabled);
+
+			// Reset all task type statistics
+			void Reset();
+
+			// Record a processed step of a task
+			void RecordTaskStep(const std::type_info &taskType, TelemetryClock::duration startLatency, TelemetryClock::duration stepDuration, TaskDoneResult::ResultType stepResult);
+
+			// Fill task type statistics of the snapshot
+			void FillTaskTypeSnapshot(TaskTelemetrySnapshot &outSnapshot);
+
+			inline uint64_t ToMicroseconds(TelemetryClock::duration duration)
+			{
+				long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+				return ((microseconds > 0) ? static_cast<uint64_t>(microseconds) : 0);
+			}
+		}
+	}
+}
+
+#endif
@@ -25,6 +25,20 @@ namespace Leggiero
 	{
 		using SchedulingClock = std::chrono::system_clock;
 
+		namespace _Internal
+		{
+			// Scheduling time given by a task manager with its own clock, while it processes tasks on current thread
+			inline thread_local const SchedulingClock::time_point *t_schedulingTimeOverride = nullptr;
+		}
+
+		// Current time to check task deadlines against
+		// Virtual time in the processing of DeterministicTaskManager, otherwise SchedulingClock::now().
+		inline SchedulingClock::time_point GetSchedulingTime()
+		{
+			const SchedulingClock::time_point *overriddenTime = _Internal::t_schedulingTimeOverride;
+			return ((overriddenTime != nullptr) ? *overriddenTime : SchedulingClock::now());
+		}
+
 
 		// Result for Task Doing Step
 		struct TaskDoneResult
@@ -64,6 +78,7 @@ namespace Leggiero
 			kNone = 0x0, 
 
 			kHasError = 0x1,
+			kIsCancelled = 0x2,
 
 			kJobQueued = 0x10,
 			kJobStarted = 0x20,
@@ -75,6 +90,7 @@ namespace Leggiero
 			kContinueWaiting = (kJobQueued | kJobStarted),
 			kDone = (kJobStarted | kJobFinished),
 			kError = (kJobStarted | kJobFinished | kHasError),
+			kCancelled = (kJobFinished | kHasError | kIsCancelled),
 		};
 		MAKE_ENUM_FLAG(TaskState);
 
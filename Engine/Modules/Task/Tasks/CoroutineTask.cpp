@@ -0,0 +1,111 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/CoroutineTask.cpp (Leggiero/Modules - Task)
+//
+// Coroutine Task Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "CoroutineTask.h"
+
+#ifdef _LEGGIERO_TASK_COROUTINE_SUPPORTED
+
+// Leggiero.Task
+#include "../_Internal/_TaskMemoryPool.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		//////////////////////////////////////////////////////////////////////////////// Coroutine Frame Pool
+
+		namespace _Internal
+		{
+			//------------------------------------------------------------------------------
+			void *AllocateCoroutineFrame(std::size_t frameSize)
+			{
+				return AllocateTaskMemoryBlock(frameSize);
+			}
+
+			//------------------------------------------------------------------------------
+			void FreeCoroutineFrame(void *frame, std::size_t frameSize)
+			{
+				FreeTaskMemoryBlock(frame, frameSize);
+			}
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// CoroutineTask
+
+		//------------------------------------------------------------------------------
+		CoroutineTask::CoroutineTask(CoroutineTaskBody &&body, TaskCapabilityType capabilities, TaskPriorityClass priority, TaskPropertyType taskProperty)
+			: m_body(std::move(body))
+			, m_taskPriority(priority), m_taskProperty(taskProperty), m_taskCapabilities(capabilities)
+		{
+		}
+
+		//------------------------------------------------------------------------------
+		// Check whether the task is ready or not
+		bool CoroutineTask::IsTaskReady()
+		{
+			if (!m_body.IsValid())
+			{
+				return true;
+			}
+			return m_body.GetHandle().promise().IsWaitingReady();
+		}
+
+		//------------------------------------------------------------------------------
+		// Start waiting the awaited task by finish notification
+		bool CoroutineTask::WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution)
+		{
+			if (!m_body.IsValid())
+			{
+				return false;
+			}
+
+			CoroutineTaskBody::promise_type &promise = m_body.GetHandle().promise();
+			if (!promise.waitingTask || promise.waitingCondition)
+			{
+				// Condition should be polled
+				return false;
+			}
+
+			return _WaitAllPriorTasksNotified(parkingExecution, &promise.waitingTask, &promise.waitingTask + 1);
+		}
+
+		//------------------------------------------------------------------------------
+		// Do Real Task Works
+		TaskDoneResult CoroutineTask::Do()
+		{
+			if (!m_body.IsValid() || m_body.GetHandle().done())
+			{
+				SetErrorFlag();
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+			CoroutineTaskBody::HandleType &handle = m_body.GetHandle();
+			if (!handle.promise().IsWaitingReady())
+			{
+				return TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+			}
+
+			handle.promise().ClearWaiting();
+			handle.resume();
+
+			if (handle.promise().exception)
+			{
+				SetErrorFlag();
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+			if (handle.done())
+			{
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+			return handle.promise().suspendResult;
+		}
+	}
+}
+
+#endif
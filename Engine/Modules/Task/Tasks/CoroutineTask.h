@@ -0,0 +1,236 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/CoroutineTask.h (Leggiero/Modules - Task)
+//
+// Task written as a C++20 coroutine
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASKS__COROUTINE_TASK_H
+#define __LM_TASK__TASKS__COROUTINE_TASK_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Coroutine support needs C++20 compilation
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+	#if __has_include(<coroutine>)
+		#define _LEGGIERO_TASK_COROUTINE_SUPPORTED 1
+	#endif
+#endif
+
+#ifdef _LEGGIERO_TASK_COROUTINE_SUPPORTED
+
+// Standard Library
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Leggiero.Task
+#include "ITask.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		namespace _Internal
+		{
+			// Pooled allocation of coroutine frames
+			void *AllocateCoroutineFrame(std::size_t frameSize);
+			void FreeCoroutineFrame(void *frame, std::size_t frameSize);
+		}
+
+
+		namespace Coroutine
+		{
+			// co_await to yield the processing (kYield)
+			struct Yield { };
+
+			// co_await to wait until the condition becomes true (kWaitCondition)
+			// The condition is polled by the task system.
+			struct WaitCondition
+			{
+			public:
+				std::function<bool()> condition;
+			};
+		}
+
+
+		// Return type of a coroutine function for CoroutineTask
+		//   co_await Coroutine::Yield()					: yield
+		//   co_await std::chrono::milliseconds(n)		: sleep for the duration
+		//   co_await std::shared_ptr<SomeTask>			: wait the task finished, notified without polling
+		//   co_await Coroutine::WaitCondition{ func }	: wait until the condition met
+		class CoroutineTaskBody
+		{
+		public:
+			struct promise_type
+			{
+			public:
+				promise_type()
+					: suspendResult(TaskDoneResult::ResultType::kYield)
+				{ }
+
+			public:
+				CoroutineTaskBody get_return_object() { return CoroutineTaskBody(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+				// Start at the first Do of the task, not at the creation
+				std::suspend_always initial_suspend() noexcept { return { }; }
+				std::suspend_always final_suspend() noexcept { return { }; }
+
+				void return_void() { }
+				void unhandled_exception() { exception = std::current_exception(); }
+
+			public:	// Frames from pool
+				static void *operator new(std::size_t frameSize) { return _Internal::AllocateCoroutineFrame(frameSize); }
+				static void operator delete(void *frame, std::size_t frameSize) { _Internal::FreeCoroutineFrame(frame, frameSize); }
+
+			public:	// Await Points
+				std::suspend_always await_transform(Coroutine::Yield)
+				{
+					suspendResult = TaskDoneResult(TaskDoneResult::ResultType::kYield);
+					return { };
+				}
+
+				template <typename RepT, typename PeriodT>
+				std::suspend_always await_transform(std::chrono::duration<RepT, PeriodT> duration)
+				{
+					suspendResult = TaskDoneResult(TaskDoneResult::ResultType::kSleep, std::chrono::duration_cast<SchedulingClock::duration>(duration));
+					return { };
+				}
+
+				std::suspend_always await_transform(Coroutine::WaitCondition waitCondition)
+				{
+					waitingCondition = std::move(waitCondition.condition);
+					suspendResult = TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+					return { };
+				}
+
+				template <typename TaskT, typename std::enable_if<std::is_base_of<ITask, TaskT>::value, int>::type = 0>
+				std::suspend_always await_transform(std::shared_ptr<TaskT> task)
+				{
+					waitingTask = std::move(task);
+					suspendResult = TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+					return { };
+				}
+
+			public:
+				bool IsWaitingReady()
+				{
+					if (waitingTask && !waitingTask->IsFinished())
+					{
+						return false;
+					}
+					if (waitingCondition && !waitingCondition())
+					{
+						return false;
+					}
+					return true;
+				}
+
+				void ClearWaiting()
+				{
+					waitingTask.reset();
+					waitingCondition = nullptr;
+					suspendResult = TaskDoneResult(TaskDoneResult::ResultType::kYield);
+				}
+
+			public:
+				TaskDoneResult			suspendResult;
+				std::shared_ptr<ITask>	waitingTask;
+				std::function<bool()>	waitingCondition;
+				std::exception_ptr		exception;
+			};
+
+			using HandleType = std::coroutine_handle<promise_type>;
+
+		public:
+			CoroutineTaskBody()
+				: m_handle(nullptr)
+			{ }
+
+			CoroutineTaskBody(CoroutineTaskBody &&other) noexcept
+				: m_handle(std::exchange(other.m_handle, nullptr))
+			{ }
+
+			CoroutineTaskBody &operator=(CoroutineTaskBody &&other) noexcept
+			{
+				if (this != &other)
+				{
+					_Destroy();
+					m_handle = std::exchange(other.m_handle, nullptr);
+				}
+				return *this;
+			}
+
+			CoroutineTaskBody(const CoroutineTaskBody &other) = delete;
+			CoroutineTaskBody &operator=(const CoroutineTaskBody &other) = delete;
+
+			~CoroutineTaskBody() { _Destroy(); }
+
+		public:
+			bool IsValid() const { return static_cast<bool>(m_handle); }
+			HandleType &GetHandle() { return m_handle; }
+
+		protected:
+			explicit CoroutineTaskBody(HandleType handle)
+				: m_handle(handle)
+			{ }
+
+			void _Destroy()
+			{
+				if (m_handle)
+				{
+					m_handle.destroy();
+					m_handle = nullptr;
+				}
+			}
+
+		protected:
+			HandleType m_handle;
+		};
+
+
+		// Task processing a coroutine step by step
+		// Each suspension of the coroutine is mapped to the task done result.
+		class CoroutineTask
+			: public ITask
+		{
+		public:
+			CoroutineTask(CoroutineTaskBody &&body,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault, TaskPropertyType taskProperty = TaskPropertyType::kNone);
+			virtual ~CoroutineTask() { }
+
+		public:	// Task Properties
+			virtual TaskPriorityClass	GetTaskPriority() override { return m_taskPriority; }
+			virtual TaskPropertyType	GetTaskProperty() override { return m_taskProperty; }
+			virtual TaskCapabilityType	GetRequiredCapabilties() override { return m_taskCapabilities; }
+
+		public:	// ITask
+			// Check whether the task is ready or not
+			virtual bool IsTaskReady() override;
+
+			// Start waiting the awaited task by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override;
+
+			// Do Real Task Works
+			virtual TaskDoneResult Do() override;
+
+		protected:
+			CoroutineTaskBody m_body;
+
+			TaskPriorityClass	m_taskPriority;
+			TaskPropertyType	m_taskProperty;
+			TaskCapabilityType	m_taskCapabilities;
+		};
+	}
+}
+
+#endif
+
+#endif
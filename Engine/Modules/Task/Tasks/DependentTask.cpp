@@ -68,6 +68,13 @@ namespace Leggiero
 			return _DoWork();
 		}
 
+		//------------------------------------------------------------------------------
+		// Start waiting prior tasks by finish notification
+		bool DependentTask::WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution)
+		{
+			return _WaitAllPriorTasksNotified(parkingExecution, m_dependsOn.begin(), m_dependsOn.end());
+		}
+
 		//------------------------------------------------------------------------------
 		std::shared_ptr<ITask> DependentTask::GetPriorTaskOf(int index)
 		{
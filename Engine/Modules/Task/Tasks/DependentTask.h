@@ -50,6 +50,9 @@ namespace Leggiero
 			// Do Real Task Works
 			virtual TaskDoneResult Do() override;
 
+			// Start waiting prior tasks by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override;
+
 		public:
 			const std::vector<std::shared_ptr<ITask> > &GetPriorTasks() { return m_dependsOn; }
 			std::shared_ptr<ITask> GetPriorTaskOf(int index);
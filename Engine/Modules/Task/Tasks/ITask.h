@@ -12,23 +12,46 @@
 #include <Basic/LeggieroBasic.h>
 
 // Standard Library
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <vector>
 
 // Leggiero.Task
 #include "../TaskTypes.h"
+#include "TaskCancellationToken.h"
 
 
 namespace Leggiero
 {
 	namespace Task
 	{
+		// Forward Declarations
+		class ITask;
+		struct TaskExecutionEntry;
+
+
+		// Dependent task parked until its prior tasks finish
+		// Prior tasks hold the dependent weakly; the parked execution is kept in the dependent task itself.
+		struct DependentExecutionLink
+		{
+		public:
+			std::weak_ptr<ITask>	task;
+		};
+
+
 		// Interface for a Task
 		class ITask
 		{
 		public:
 			ITask()
 				: m_currentState(TaskState::kNone)
-			{ }
+				, m_deadline(SchedulingClock::time_point::max())
+				, m_unfinishedPriorCount(0), m_isDependentListClosed(false)
+				, m_parkedExecution(nullptr), m_isParkingPolled(false)
+			{
+				m_dependentListLock.clear();
+			}
 
 			virtual ~ITask() { }
 
@@ -49,6 +72,18 @@ namespace Leggiero
 			bool IsFinished() const { return Utility::SyntacticSugar::HasFlag(GetTaskState(), TaskState::kJobFinished); }
 			// Check there was an error during task execution
 			bool HasError() const { return Utility::SyntacticSugar::HasFlag(GetTaskState(), TaskState::kHasError); }
+			// Check the task was dropped by cancellation or deadline; also finished with error
+			bool IsCancelled() const { return Utility::SyntacticSugar::HasFlag(GetTaskState(), TaskState::kIsCancelled); }
+
+		public:	// Cancellation
+			// Set before executing the task
+			void SetCancellationToken(const std::shared_ptr<TaskCancellationToken> &token) { m_cancellationToken = token; }
+			const std::shared_ptr<TaskCancellationToken> &GetCancellationToken() const { return m_cancellationToken; }
+
+			// A task not started until the deadline is dropped instead of run
+			// Deadline is on the clock of GetSchedulingTime; use DeterministicTaskManager::SetVirtualDeadline for the virtual clock.
+			void SetDeadline(SchedulingClock::time_point deadline) { m_deadline = deadline; }
+			SchedulingClock::time_point GetDeadline() const { return m_deadline; }
 
 		public:	// Task Implementations
 			// Do Real Task Works
@@ -76,8 +111,161 @@ namespace Leggiero
 				} while (!m_currentState.compare_exchange_weak(storedValue, flagedValue));
 			}
 
+			// Check whether the task should be dropped at this scheduling point
+			bool IsDropRequested(SchedulingClock::time_point now) const
+			{
+				if (m_cancellationToken && m_cancellationToken->IsCancelled())
+				{
+					return true;
+				}
+				return (m_deadline < now && !Utility::SyntacticSugar::HasFlag(GetTaskState(), TaskState::kJobStarted));
+			}
+
+			bool IsDropRequested() const
+			{
+				if (m_cancellationToken && m_cancellationToken->IsCancelled())
+				{
+					return true;
+				}
+				return (m_deadline != SchedulingClock::time_point::max() && IsDropRequested(GetSchedulingTime()));
+			}
+
+			// Finish the task as cancelled
+			void MarkDropped()
+			{
+				TaskState storedValue;
+				TaskState droppedValue;
+				do
+				{
+					storedValue = m_currentState.load();
+					droppedValue = (storedValue | TaskState::kCancelled);
+				} while (!m_currentState.compare_exchange_weak(storedValue, droppedValue));
+			}
+
+		public:	// Task Graph - for task system
+			// Start waiting prior tasks by finish notification, instead of polling IsTaskReady.
+			// Returns true if the execution is parked and will be requested again by the prior tasks.
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &/*parkingExecution*/) { return false; }
+
+			// Called when a prior task that the parked execution waits for finished
+			// Returns true if the execution should be resumed by the notification.
+			bool NotifyPriorTaskFinished() { return (m_unfinishedPriorCount.fetch_sub(1) == 1); }
+
+			// Keep the execution in the task before waiting prior tasks
+			void ParkExecution(TaskExecutionEntry *execution) { m_parkedExecution.store(execution); }
+
+			// Claim the parked execution to resume or drop it
+			// Both of the notification and the polling of the task manager can resume the execution, but only one of them gets it.
+			TaskExecutionEntry *TakeParkedExecution() { return m_parkedExecution.exchange(nullptr); }
+			bool HasParkedExecution() const { return (m_parkedExecution.load() != nullptr); }
+
+			// Mark the task is in the polling list of the task manager; returns false if already marked
+			bool MarkParkingPolled() { return !m_isParkingPolled.exchange(true); }
+			void ClearParkingPolled() { m_isParkingPolled.store(false); }
+
+			// Register an execution of dependent task to be notified when this task finished
+			// Returns false if the task already finished and the execution is not registered.
+			bool RegisterDependentExecution(const DependentExecutionLink &dependentExecution)
+			{
+				while (m_dependentListLock.test_and_set(std::memory_order_acquire)) { }
+
+				bool isRegistered = false;
+				if (!m_isDependentListClosed)
+				{
+					if (m_dependentExecutions.size() == m_dependentExecutions.capacity())
+					{
+						// Links of released dependents are removed before growing, not to pile up on a long-running task
+						m_dependentExecutions.erase(std::remove_if(m_dependentExecutions.begin(), m_dependentExecutions.end(),
+							[](const DependentExecutionLink &link) { return link.task.expired(); }), m_dependentExecutions.end());
+					}
+					m_dependentExecutions.push_back(dependentExecution);
+					isRegistered = true;
+				}
+
+				m_dependentListLock.clear(std::memory_order_release);
+				return isRegistered;
+			}
+
+			// Close dependent registration and take registered executions
+			void TakeDependentExecutions(std::vector<DependentExecutionLink> &outExecutions)
+			{
+				while (m_dependentListLock.test_and_set(std::memory_order_acquire)) { }
+
+				m_isDependentListClosed = true;
+				outExecutions.swap(m_dependentExecutions);
+
+				m_dependentListLock.clear(std::memory_order_release);
+			}
+
+		protected:	// Task Graph Helpers
+			// Park the execution until all of the prior tasks finish
+			template <typename PriorIteratorT>
+			bool _WaitAllPriorTasksNotified(const DependentExecutionLink &parkingExecution, PriorIteratorT first, PriorIteratorT last)
+			{
+				// Hold one count during registration not to be resumed by already notified priors
+				m_unfinishedPriorCount.store(1);
+
+				for (PriorIteratorT it = first; it != last; ++it)
+				{
+					if (!(*it))
+					{
+						continue;
+					}
+					if ((*it)->IsFinished())
+					{
+						continue;
+					}
+
+					m_unfinishedPriorCount.fetch_add(1);
+					if (!(*it)->RegisterDependentExecution(parkingExecution))
+					{
+						// Finished during registration
+						m_unfinishedPriorCount.fetch_sub(1);
+					}
+				}
+
+				// Release holding count. If it was the last, every prior task was finished before being waited.
+				return !NotifyPriorTaskFinished();
+			}
+
+			// Park the execution until any of the prior tasks finishes
+			//note: late notifications from other priors only decrease the count under zero, so never resume the execution
+			template <typename PriorIteratorT>
+			bool _WaitAnyPriorTaskNotified(const DependentExecutionLink &parkingExecution, PriorIteratorT first, PriorIteratorT last)
+			{
+				// The first finished prior resumes the execution
+				m_unfinishedPriorCount.store(1);
+
+				bool isAnyFinished = false;
+				for (PriorIteratorT it = first; it != last; ++it)
+				{
+					if (!(*it))
+					{
+						continue;
+					}
+					if ((*it)->IsFinished() || !(*it)->RegisterDependentExecution(parkingExecution))
+					{
+						isAnyFinished = true;
+						break;
+					}
+				}
+
+				return !isAnyFinished;
+			}
+
 		protected:
 			std::atomic<TaskState>	m_currentState;
+
+			std::shared_ptr<TaskCancellationToken>	m_cancellationToken;
+			SchedulingClock::time_point				m_deadline;
+
+			std::atomic_int						m_unfinishedPriorCount;
+			std::atomic_flag					m_dependentListLock;
+			bool								m_isDependentListClosed;
+			std::vector<DependentExecutionLink>	m_dependentExecutions;
+
+			std::atomic<TaskExecutionEntry *>	m_parkedExecution;
+			std::atomic_bool					m_isParkingPolled;
 		};
 	}
 }
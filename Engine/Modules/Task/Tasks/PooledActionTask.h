@@ -0,0 +1,116 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/PooledActionTask.h (Leggiero/Modules - Task)
+//
+// Single action task without heap allocation
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASKS__POOLED_ACTION_TASK_H
+#define __LM_TASK__TASKS__POOLED_ACTION_TASK_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Leggiero.Task
+#include "ITask.h"
+#include "../_Internal/_TaskMemoryPool.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		// Task that executes a given action once, for fire-and-forget micro tasks
+		// Created by Create(): the task object and its reference count share one pooled block,
+		// and an action fits in the inline buffer is stored without any allocation.
+		class PooledActionTask
+			: public ITask
+		{
+		public:
+			// Actions bigger than this are stored on the heap
+			static constexpr std::size_t kInlineActionSize = 64;
+
+		public:
+			template <typename ActionT>
+			static std::shared_ptr<PooledActionTask> Create(ActionT &&action,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault, TaskPropertyType taskProperty = TaskPropertyType::kNone)
+			{
+				return std::allocate_shared<PooledActionTask>(_Internal::TaskMemoryPoolAllocator<PooledActionTask>(),
+					std::forward<ActionT>(action), capabilities, priority, taskProperty);
+			}
+
+		public:
+			// Use Create() instead; public for std::allocate_shared
+			template <typename ActionT>
+			PooledActionTask(ActionT &&action, TaskCapabilityType capabilities, TaskPriorityClass priority, TaskPropertyType taskProperty)
+				: m_taskPriority(priority), m_taskProperty(taskProperty), m_taskCapabilities(capabilities)
+			{
+				using StoredActionT = typename std::decay<ActionT>::type;
+				if constexpr (sizeof(StoredActionT) <= kInlineActionSize && alignof(StoredActionT) <= alignof(std::max_align_t))
+				{
+					new (m_actionStorage) StoredActionT(std::forward<ActionT>(action));
+					m_invokeFunc = &_InvokeInline<StoredActionT>;
+					m_destroyFunc = &_DestroyInline<StoredActionT>;
+				}
+				else
+				{
+					*reinterpret_cast<StoredActionT **>(m_actionStorage) = new StoredActionT(std::forward<ActionT>(action));
+					m_invokeFunc = &_InvokeHeap<StoredActionT>;
+					m_destroyFunc = &_DestroyHeap<StoredActionT>;
+				}
+			}
+
+			virtual ~PooledActionTask()
+			{
+				m_destroyFunc(m_actionStorage);
+			}
+
+			PooledActionTask(const PooledActionTask &other) = delete;
+			PooledActionTask &operator=(const PooledActionTask &other) = delete;
+
+		public:	// Task Properties
+			virtual TaskPriorityClass	GetTaskPriority() override { return m_taskPriority; }
+			virtual TaskPropertyType	GetTaskProperty() override { return m_taskProperty; }
+			virtual TaskCapabilityType	GetRequiredCapabilties() override { return m_taskCapabilities; }
+
+		public:
+			// Do Real Task Works
+			virtual TaskDoneResult Do() override
+			{
+				m_invokeFunc(m_actionStorage);
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+		protected:
+			template <typename StoredActionT>
+			static void _InvokeInline(void *storage) { (*reinterpret_cast<StoredActionT *>(storage))(); }
+
+			template <typename StoredActionT>
+			static void _DestroyInline(void *storage) { reinterpret_cast<StoredActionT *>(storage)->~StoredActionT(); }
+
+			template <typename StoredActionT>
+			static void _InvokeHeap(void *storage) { (**reinterpret_cast<StoredActionT **>(storage))(); }
+
+			template <typename StoredActionT>
+			static void _DestroyHeap(void *storage) { delete *reinterpret_cast<StoredActionT **>(storage); }
+
+		protected:
+			alignas(std::max_align_t) unsigned char m_actionStorage[kInlineActionSize];
+			void (*m_invokeFunc)(void *);
+			void (*m_destroyFunc)(void *);
+
+			TaskPriorityClass	m_taskPriority;
+			TaskPropertyType	m_taskProperty;
+			TaskCapabilityType	m_taskCapabilities;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,59 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/TaskCancellationToken.cpp (Leggiero/Modules - Task)
+//
+// Task Cancellation Token Implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "TaskCancellationToken.h"
+
+// Leggiero.Utility
+#include <Utility/Sugar/EventNotifier.h>
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+		namespace
+		{
+			//------------------------------------------------------------------------------
+			// Created at the first use, not to depend on static initialization order
+			Utility::DesignPattern::EventNotifier<ITaskCancellationObserver *> &_GetCancellationNotifier()
+			{
+				static Utility::DesignPattern::EventNotifier<ITaskCancellationObserver *> s_cancellationNotifier;
+				return s_cancellationNotifier;
+			}
+		}
+
+
+		//////////////////////////////////////////////////////////////////////////////// TaskCancellationToken
+
+		std::atomic<uint64_t> TaskCancellationToken::ms_cancellationEpoch(0);
+
+		//------------------------------------------------------------------------------
+		void TaskCancellationToken::Cancel()
+		{
+			bool wasCancelled = m_isCancelled.exchange(true, std::memory_order_acq_rel);
+			if (!wasCancelled)
+			{
+				ms_cancellationEpoch.fetch_add(1, std::memory_order_acq_rel);
+				_GetCancellationNotifier().NotifyEvent([](ITaskCancellationObserver *observer) { observer->OnTaskCancelled(); });
+			}
+		}
+
+		//------------------------------------------------------------------------------
+		void TaskCancellationToken::RegisterCancellationObserver(ITaskCancellationObserver *observer)
+		{
+			_GetCancellationNotifier().RegisterObserver(observer);
+		}
+
+		//------------------------------------------------------------------------------
+		void TaskCancellationToken::UnRegisterCancellationObserver(ITaskCancellationObserver *observer)
+		{
+			_GetCancellationNotifier().UnRegisterObserver(observer);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/TaskCancellationToken.h (Leggiero/Modules - Task)
+//
+// Cancellation token shared by a group of tasks
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASKS__TASK_CANCELLATION_TOKEN_H
+#define __LM_TASK__TASKS__TASK_CANCELLATION_TOKEN_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		// Observer Interface to be notified of cancellations
+		// Called on the cancelling thread; for schedulers to sweep at once instead of at their next wake-up.
+		class ITaskCancellationObserver
+		{
+		public:
+			virtual void OnTaskCancelled() { }
+		};
+
+
+		// Cooperative cancellation of a task group
+		// Tasks holding a cancelled token are dropped without running at their next scheduling point:
+		// when dequeued by a worker, fired by the timer, or checked in condition waiting.
+		// A step already running is not interrupted.
+		class TaskCancellationToken
+		{
+		public:
+			static std::shared_ptr<TaskCancellationToken> Create() { return std::make_shared<TaskCancellationToken>(); }
+
+		public:
+			TaskCancellationToken()
+				: m_isCancelled(false)
+			{ }
+
+			TaskCancellationToken(const TaskCancellationToken &other) = delete;
+			TaskCancellationToken &operator=(const TaskCancellationToken &other) = delete;
+
+		public:
+			void Cancel();
+			bool IsCancelled() const { return m_isCancelled.load(std::memory_order_acquire); }
+
+		public:
+			// Increased on every cancellation, for schedulers to sweep parked executions only when needed
+			static uint64_t GetCancellationEpoch() { return ms_cancellationEpoch.load(std::memory_order_acquire); }
+
+			// Observers are notified after the epoch increased
+			static void RegisterCancellationObserver(ITaskCancellationObserver *observer);
+			static void UnRegisterCancellationObserver(ITaskCancellationObserver *observer);
+
+		protected:
+			std::atomic_bool m_isCancelled;
+
+			static std::atomic<uint64_t> ms_cancellationEpoch;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,357 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// Tasks/ValueTaskCombinators.h (Leggiero/Modules - Task)
+//
+// Continuation and combinator tasks for value tasks
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK__TASKS__VALUE_TASK_COMBINATORS_H
+#define __LM_TASK__TASKS__VALUE_TASK_COMBINATORS_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Leggiero.Task
+#include "ValueTasks.h"
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		namespace _Internal
+		{
+			// Input task is finished, or cancelled not to be finished by a task manager
+			inline bool IsCombinatorInputSettled(const ITask *inputTask)
+			{
+				return (inputTask == nullptr || inputTask->IsFinished() || inputTask->IsDropRequested());
+			}
+
+			// Input task is settled without a valid result
+			inline bool IsCombinatorInputFailed(const ITask *inputTask)
+			{
+				if (inputTask == nullptr)
+				{
+					return true;
+				}
+				if (inputTask->IsFinished())
+				{
+					return inputTask->HasError();
+				}
+				return inputTask->IsDropRequested();
+			}
+		}
+
+
+		// Continuation task to calculate a value from the result of the input task
+		// Resumed by the finish of the input task, and takes over the input value by moving.
+		// Finishes with error if the input task is cancelled, even when the input has never been given to a task manager.
+		// The input task should have no other consumer of its value.
+		template <typename InputValueT, typename ValueT>
+		class ContinuationValueTask
+			: public IAsyncValueTask<ValueT>
+		{
+		public:
+			// Dependent prior task result type
+			using InputValueType = InputValueT;
+
+			// Type for a calculation function
+			using CalculationFuncType = std::function<ValueT(InputValueT &&)>;
+
+		public:
+			ContinuationValueTask(CalculationFuncType calculation, std::shared_ptr<IAsyncValueTask<InputValueT> > inputTask,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault, TaskPropertyType taskProperty = TaskPropertyType::kNone)
+				: IAsyncValueTask<ValueT>(capabilities, priority, taskProperty)
+				, m_calculation(std::move(calculation)), m_inputTask(std::move(inputTask))
+			{ }
+			virtual ~ContinuationValueTask() { }
+
+		public:	// ITask
+			// Check whether the task is ready or not
+			virtual bool IsTaskReady() override
+			{
+				return _Internal::IsCombinatorInputSettled(m_inputTask.get());
+			}
+
+			// Start waiting the input task by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override
+			{
+				return this->_WaitAllPriorTasksNotified(parkingExecution, &m_inputTask, &m_inputTask + 1);
+			}
+
+			// Do Real Task Works
+			virtual TaskDoneResult Do() override
+			{
+				if (!m_inputTask || !m_calculation)
+				{
+					this->SetErrorFlag();
+					return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+				}
+				if (!_Internal::IsCombinatorInputSettled(m_inputTask.get()))
+				{
+					return TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+				}
+				if (!m_inputTask->HasValue())
+				{
+					// Propagate error of the input
+					this->SetErrorFlag();
+					return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+				}
+
+				m_resultValue = m_calculation(m_inputTask->TakeValue());
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+		public:	//IAsyncValueTask
+			// Check whether the task have result value
+			virtual bool HasValue() const override
+			{
+				TaskState taskState = this->GetTaskState();
+				return (Utility::SyntacticSugar::HasFlag(taskState, TaskState::kJobFinished)
+					&& !Utility::SyntacticSugar::HasFlag(taskState, TaskState::kHasError));
+			}
+
+			// Get result value
+			virtual ValueT GetValue() override { return m_resultValue; }
+
+			// Take result value out of the task by moving
+			virtual ValueT TakeValue() override { return std::move(m_resultValue); }
+
+		protected:
+			CalculationFuncType								m_calculation;
+			ValueT											m_resultValue;
+			std::shared_ptr<IAsyncValueTask<InputValueT> >	m_inputTask;
+		};
+
+
+		// Task to collect values of all input tasks
+		// Has error if any of the inputs has error or is cancelled, as soon as it happens without waiting the others.
+		// Values are moved out of the input tasks.
+		template <typename ValueT>
+		class WhenAllValueTask
+			: public IAsyncValueTask<std::vector<ValueT> >
+		{
+		public:
+			// Input task result type
+			using InputValueType = ValueT;
+
+		public:
+			WhenAllValueTask(std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > > inputTasks,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault, TaskPropertyType taskProperty = TaskPropertyType::kNone)
+				: IAsyncValueTask<std::vector<ValueT> >(capabilities, priority, taskProperty)
+				, m_inputTasks(std::move(inputTasks))
+			{ }
+			virtual ~WhenAllValueTask() { }
+
+		public:	// ITask
+			// Check whether the task is ready or not
+			virtual bool IsTaskReady() override
+			{
+				bool isAllFinished = true;
+				for (const std::shared_ptr<IAsyncValueTask<ValueT> > &checkingTask : m_inputTasks)
+				{
+					if (!checkingTask)
+					{
+						continue;
+					}
+					if (_Internal::IsCombinatorInputFailed(checkingTask.get()))
+					{
+						return true;
+					}
+					if (!checkingTask->IsFinished())
+					{
+						isAllFinished = false;
+					}
+				}
+				return isAllFinished;
+			}
+
+			// Start waiting the input tasks by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override
+			{
+				return this->_WaitAllPriorTasksNotified(parkingExecution, m_inputTasks.begin(), m_inputTasks.end());
+			}
+
+			// Do Real Task Works
+			virtual TaskDoneResult Do() override
+			{
+				if (!IsTaskReady())
+				{
+					return TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+				}
+
+				// Check all before taking, not to consume values of the inputs on error
+				m_resultValue.clear();
+				for (const std::shared_ptr<IAsyncValueTask<ValueT> > &currentTask : m_inputTasks)
+				{
+					if (!currentTask || !currentTask->HasValue())
+					{
+						this->SetErrorFlag();
+						return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+					}
+				}
+
+				m_resultValue.reserve(m_inputTasks.size());
+				for (const std::shared_ptr<IAsyncValueTask<ValueT> > &currentTask : m_inputTasks)
+				{
+					m_resultValue.push_back(currentTask->TakeValue());
+				}
+
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+		public:	//IAsyncValueTask
+			// Check whether the task have result value
+			virtual bool HasValue() const override
+			{
+				TaskState taskState = this->GetTaskState();
+				return (Utility::SyntacticSugar::HasFlag(taskState, TaskState::kJobFinished)
+					&& !Utility::SyntacticSugar::HasFlag(taskState, TaskState::kHasError));
+			}
+
+			// Get result value
+			virtual std::vector<ValueT> GetValue() override { return m_resultValue; }
+
+			// Take result value out of the task by moving
+			virtual std::vector<ValueT> TakeValue() override { return std::move(m_resultValue); }
+
+		protected:
+			std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > >	m_inputTasks;
+			std::vector<ValueT>										m_resultValue;
+		};
+
+
+		// Task to get the value of the first finished input task, with the index of the input
+		// Has error if the first finished input has error. A cancelled input counts as finished with error.
+		// The value is moved out of the input task.
+		template <typename ValueT>
+		class WhenAnyValueTask
+			: public IAsyncValueTask<std::pair<size_t, ValueT> >
+		{
+		public:
+			// Input task result type
+			using InputValueType = ValueT;
+
+		public:
+			WhenAnyValueTask(std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > > inputTasks,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault, TaskPropertyType taskProperty = TaskPropertyType::kNone)
+				: IAsyncValueTask<std::pair<size_t, ValueT> >(capabilities, priority, taskProperty)
+				, m_inputTasks(std::move(inputTasks))
+			{ }
+			virtual ~WhenAnyValueTask() { }
+
+		public:	// ITask
+			// Check whether the task is ready or not
+			virtual bool IsTaskReady() override
+			{
+				return (_FindFinishedInputIndex() >= 0);
+			}
+
+			// Start waiting the input tasks by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override
+			{
+				return this->_WaitAnyPriorTaskNotified(parkingExecution, m_inputTasks.begin(), m_inputTasks.end());
+			}
+
+			// Do Real Task Works
+			virtual TaskDoneResult Do() override
+			{
+				if (m_inputTasks.empty())
+				{
+					this->SetErrorFlag();
+					return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+				}
+
+				int finishedIndex = _FindFinishedInputIndex();
+				if (finishedIndex < 0)
+				{
+					return TaskDoneResult(TaskDoneResult::ResultType::kWaitCondition);
+				}
+
+				const std::shared_ptr<IAsyncValueTask<ValueT> > &finishedTask = m_inputTasks[finishedIndex];
+				if (!finishedTask || !finishedTask->HasValue())
+				{
+					this->SetErrorFlag();
+					return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+				}
+
+				m_resultValue = std::make_pair(static_cast<size_t>(finishedIndex), finishedTask->TakeValue());
+				return TaskDoneResult(TaskDoneResult::ResultType::kFinished);
+			}
+
+		public:	//IAsyncValueTask
+			// Check whether the task have result value
+			virtual bool HasValue() const override
+			{
+				TaskState taskState = this->GetTaskState();
+				return (Utility::SyntacticSugar::HasFlag(taskState, TaskState::kJobFinished)
+					&& !Utility::SyntacticSugar::HasFlag(taskState, TaskState::kHasError));
+			}
+
+			// Get result value
+			virtual std::pair<size_t, ValueT> GetValue() override { return m_resultValue; }
+
+			// Take result value out of the task by moving
+			virtual std::pair<size_t, ValueT> TakeValue() override { return std::move(m_resultValue); }
+
+		protected:
+			int _FindFinishedInputIndex()
+			{
+				const int inputCount = static_cast<int>(m_inputTasks.size());
+				for (int i = 0; i < inputCount; ++i)
+				{
+					if (_Internal::IsCombinatorInputSettled(m_inputTasks[i].get()))
+					{
+						return i;
+					}
+				}
+				return -1;
+			}
+
+		protected:
+			std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > >	m_inputTasks;
+			std::pair<size_t, ValueT>								m_resultValue;
+		};
+
+
+		// Make a continuation task of the input value task
+		// Created task should be given to the task manager, and runs as soon as the input task finished.
+		template <typename InputTaskT, typename CalculationT>
+		std::shared_ptr<ContinuationValueTask<typename InputTaskT::ValueType, std::decay_t<std::invoke_result_t<CalculationT, typename InputTaskT::ValueType &&> > > >
+			Then(std::shared_ptr<InputTaskT> inputTask, CalculationT &&calculation,
+				TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault)
+		{
+			using InputValueT = typename InputTaskT::ValueType;
+			using ResultValueT = std::decay_t<std::invoke_result_t<CalculationT, InputValueT &&> >;
+
+			return std::make_shared<ContinuationValueTask<InputValueT, ResultValueT> >(std::forward<CalculationT>(calculation),
+				std::shared_ptr<IAsyncValueTask<InputValueT> >(std::move(inputTask)), capabilities, priority);
+		}
+
+		// Make a task collecting values of all input tasks
+		template <typename ValueT>
+		std::shared_ptr<WhenAllValueTask<ValueT> > WhenAll(std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > > inputTasks,
+			TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault)
+		{
+			return std::make_shared<WhenAllValueTask<ValueT> >(std::move(inputTasks), capabilities, priority);
+		}
+
+		// Make a task getting the value of the first finished input task
+		template <typename ValueT>
+		std::shared_ptr<WhenAnyValueTask<ValueT> > WhenAny(std::vector<std::shared_ptr<IAsyncValueTask<ValueT> > > inputTasks,
+			TaskCapabilityType capabilities = TaskCapabilities::kGeneral, TaskPriorityClass priority = TaskPriorityClass::kDefault)
+		{
+			return std::make_shared<WhenAnyValueTask<ValueT> >(std::move(inputTasks), capabilities, priority);
+		}
+	}
+}
+
+#endif
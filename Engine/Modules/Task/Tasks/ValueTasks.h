@@ -13,6 +13,8 @@
 
 // Standard Library
 #include <functional>
+#include <memory>
+#include <utility>
 
 // Leggiero.Task
 #include "ITask.h"
@@ -44,6 +46,10 @@ namespace Leggiero
 			// Get result value
 			virtual ValueT GetValue() = 0;
 
+			// Take result value out of the task by moving
+			// Only for the single consumer of the value. The task does not have valid value after taking.
+			virtual ValueT TakeValue() { return GetValue(); }
+
 		public:	// Task Properties
 			virtual TaskPriorityClass	GetTaskPriority() { return m_taskPriority; }
 			virtual TaskPropertyType	GetTaskProperty() { return m_taskProperty; }
@@ -99,6 +105,9 @@ namespace Leggiero
 			// Get result value
 			virtual ValueT GetValue() override { return m_resultValue; }
 
+			// Take result value out of the task by moving
+			virtual ValueT TakeValue() override { return std::move(m_resultValue); }
+
 		protected:
 			CalculationFuncType m_calculation;
 			ValueT				m_resultValue;
@@ -128,6 +137,18 @@ namespace Leggiero
 			virtual ~DependentAsyncValueTask() { }
 
 		public:	// ITask
+			// Check whether the task is ready or not
+			virtual bool IsTaskReady() override
+			{
+				return (!m_inputTask || m_inputTask->IsFinished());
+			}
+
+			// Start waiting the input task by finish notification
+			virtual bool WaitPriorTasksNotified(const DependentExecutionLink &parkingExecution) override
+			{
+				return this->_WaitAllPriorTasksNotified(parkingExecution, &m_inputTask, &m_inputTask + 1);
+			}
+
 			// Do Real Task Works
 			virtual TaskDoneResult Do() override
 			{
@@ -171,6 +192,9 @@ namespace Leggiero
 			// Get result value
 			virtual ValueT GetValue() override { return m_resultValue; }
 
+			// Take result value out of the task by moving
+			virtual ValueT TakeValue() override { return std::move(m_resultValue); }
+
 		protected:
 			CalculationFuncType								m_calculation;
 			ValueT											m_resultValue;
@@ -13,6 +13,7 @@
 
 // Standard Library
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <unordered_map>
 #include <set>
@@ -33,6 +34,7 @@
 
 // Leggiero.Task
 #include "../TaskManagerComponent.h"
+#include "../Tasks/TaskCancellationToken.h"
 
 
 namespace Leggiero
@@ -53,6 +55,7 @@ namespace Leggiero
 				: public TaskManagerComponent
 				, public Application::IApplicationEventObserver
 				, public Engine::GameProcessAnchorObserver::IAfterFrameHandler
+				, public ITaskCancellationObserver
 			{
 			public:
 				ConcreteTaskManager();
@@ -86,12 +89,18 @@ namespace Leggiero
 
 			public:	// TaskManagerComponent
 				virtual bool ExecuteTask(std::shared_ptr<ITask> task) override;
+				virtual size_t ExecuteTasks(const std::shared_ptr<ITask> *tasks, size_t taskCount) override;
+
+				virtual void GetTelemetrySnapshot(TaskTelemetrySnapshot &outSnapshot) override;
 
 			public:	// Observers
 				virtual void OnGoToBackground() override;
 				virtual void OnReturnFromBackground() override;
 				virtual void GameProcess_OnAfterFrame(GameFrameNumberType frameNumber) override;
 
+			public:	// ITaskCancellationObserver
+				virtual void OnTaskCancelled() override;
+
 			protected:	// Platform
 				std::shared_ptr<ITaskProcessor> _CreateGeneralProcessor();
 
@@ -99,11 +108,17 @@ namespace Leggiero
 				TaskExecutionEntry *_RetainExecution();
 
 				void _DispatchExecution(TaskExecutionEntry *execution);
+				void _DropExecution(TaskExecutionEntry *execution);
+				void _PlaceGameThread();
+				void _ResolveDependentExecutions(ITask &finishedTask);
 
 			protected:
 				Application::ApplicationComponent *m_appComponentCopy;
 				Engine::GameProcessAnchor *m_gameAnchor;
 
+				pthread_t	m_placedGameThread;
+				bool		m_isGameThreadPlaced;
+
 				moodycamel::ConcurrentQueue<TaskExecutionEntry *> m_executionEntryPool;
 
 				std::vector<std::shared_ptr<ITaskSubSystem> > m_subSystems;
@@ -123,15 +138,9 @@ namespace Leggiero
 				ITaskProcessor *_GetTaskProcessor(TaskCapabilityType capability);
 
 			protected:	// Realtime Scheduler
-				static constexpr size_t kRealtimeScheduleMaxBatchCount = 1024;
-
-				moodycamel::ConcurrentQueue<TaskExecutionEntry *>	m_realtimeWaitingQueue;
-
 				std::atomic_bool m_isRealtimeScheduling;
-				TaskExecutionEntry *m_realtimeSchedulingBuffer[kRealtimeScheduleMaxBatchCount];
 
 				void _HintRealtimeSchedule();
-				void _RealtimeSchedule();
 
 			protected:
 				moodycamel::ConcurrentQueue<TaskExecutionEntry *>	m_conditionWaitingQueueRealtime;
@@ -142,40 +151,60 @@ namespace Leggiero
 				std::atomic_bool m_conditionWaitingQueueProcessing;
 				std::vector<TaskExecutionEntry *> m_conditionWaitingProcessBuffer;
 
-			protected:	// Waiting Queues
-				struct SchedulingQueueEntry
+			protected:	// Parked Executions
+				// Tasks parked by WaitPriorTasksNotified; owned here while parked, and polled with long-term conditions
+				moodycamel::ConcurrentQueue<std::shared_ptr<ITask> >	m_parkedTaskQueue;
+				std::atomic_bool										m_parkedTaskProcessing;
+				std::vector<std::shared_ptr<ITask> >					m_parkedTaskProcessBuffer;
+
+				void _ProcessParkedTasks();
+				void _FinalizeParkedTasks();
+
+			protected:	// Timer Scheduler
+				struct TimerEntry
 				{
 				public:
-					SchedulingClock::duration							minimumWaiting;
-					moodycamel::ConcurrentQueue<TaskExecutionEntry *>	queue;
-
-					pthread_t				schedulingThread;
-					ConcreteTaskManager *owner;
-					int						queueIndex;
+					SchedulingClock::time_point	wakeTime;
+					TaskExecutionEntry			*execution;
 
-					std::vector<TaskExecutionEntry *> queueProcessingBuffer;
-					std::vector<TaskExecutionEntry *> queueProcessingNowBuffer;
+				public:
+					bool operator>(const TimerEntry &other) const { return wakeTime > other.wakeTime; }
 				};
 
-				std::vector<SchedulingQueueEntry *> m_schedulingQueues;
-				int									m_schedulingQueuesCount;
+				static constexpr std::chrono::milliseconds kTimerMaxWaiting = std::chrono::milliseconds(1024);
+				static constexpr std::chrono::milliseconds kRealtimeConditionCheckInterval = std::chrono::milliseconds(1);
+				static constexpr std::chrono::milliseconds kShortTermConditionCheckInterval = std::chrono::milliseconds(4);
+				static constexpr std::chrono::milliseconds kLongTermConditionCheckInterval = std::chrono::milliseconds(64);
+
+				// Sleeping executions are handed to the timer thread through the queue, and the heap is only touched by the timer thread
+				moodycamel::ConcurrentQueue<TaskExecutionEntry *>	m_timerIncomingQueue;
+				std::vector<TimerEntry>								m_timerHeap;
+				std::vector<TaskExecutionEntry *>					m_timerFiringBuffer;
+
+				pthread_t							m_timerThread;
+				bool								m_isTimerThreadCreated;
+				std::atomic<SchedulingClock::rep>	m_timerNextWakeUp;
+				std::atomic<size_t>					m_timerHeapSize;
+				uint64_t							m_timerSweptCancellationEpoch;
+
 				std::atomic_bool					m_schedulerRunning;
 				std::atomic_bool					m_schedulerPause;
 
-				int m_conditionCheckShortTermIndex;
-				int m_conditionCheckLongTermIndex;
+				SchedulingClock::time_point m_nextShortTermConditionCheck;
+				SchedulingClock::time_point m_nextLongTermConditionCheck;
 
-				Utility::Threading::SafePthreadLock					m_queuesPauseMutex;
-				Utility::Threading::SafePthreadConditionVariable	m_queuesPauseCond;
+				Utility::Threading::SafePthreadLock					m_schedulerMutex;
+				Utility::Threading::SafePthreadConditionVariable	m_schedulerCondition;
 
-				void _InitializeSchedulingQueues();
-				void _FinalizeSchedulingQueues();
+				void _InitializeTimerScheduler();
+				void _FinalizeTimerScheduler();
 
-				void _SchedulingQueueThreadFunction(SchedulingQueueEntry &queueEntry);
-				void _DoWaitingQueueScheduling(int queueIndex, SchedulingQueueEntry &queueEntry);
-				static void *_SchedulingQueueThreadStartHelper(void *threadEntry);
+				void _TimerThreadFunction();
+				SchedulingClock::time_point _DoTimerScheduling();
+				static void *_TimerThreadStartHelper(void *threadThis);
 
 				void _EnqueueWaitingExecution(TaskExecutionEntry *execution);
+				void _SweepCancelledTimerEntries();
 			};
 		}
 	}
@@ -16,6 +16,7 @@
 
 // Leggiero.Task
 #include "../TaskTypes.h"
+#include "../TaskTelemetry.h"
 
 
 namespace Leggiero
@@ -33,10 +34,18 @@ namespace Leggiero
 			std::shared_ptr<ITask>		task;
 			SchedulingClock::time_point	lastStep;
 
+			#if _LEGGIERO_TASK_TELEMETRY
+				TelemetryClock::time_point	queuedTime;		// time when given to a processor queue
+			#endif
+
 		public:
 			void Clear()
 			{
 				task.reset();
+
+				#if _LEGGIERO_TASK_TELEMETRY
+					queuedTime = TelemetryClock::time_point();
+				#endif
 			}
 		};
 	}
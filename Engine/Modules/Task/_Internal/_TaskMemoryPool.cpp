@@ -0,0 +1,198 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// _Internal/_TaskMemoryPool.cpp (Leggiero/Modules - Task)
+//
+// Task memory pool implementation
+////////////////////////////////////////////////////////////////////////////////
+
+// My Header
+#include "_TaskMemoryPool.h"
+
+// Standard Library
+#include <atomic>
+
+// External Library
+#include <concurrentqueue/concurrentqueue.h>
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		namespace _Internal
+		{
+			//////////////////////////////////////////////////////////////////////////////// Internal Utility
+
+			namespace
+			{
+				constexpr int kBlockSizeClassCount = 6;
+				constexpr std::size_t kBlockSizeClasses[kBlockSizeClassCount] = { 128, 256, 512, 1024, 2048, kMaxPooledTaskMemoryBlockSize };
+
+				// Maximum blocks kept in the shared pool per size class
+				constexpr int kMaxSharedPooledBlockCount = 1024;
+
+				// Blocks cached in each thread per size class, to avoid touching the shared pool for every allocation
+				constexpr int kThreadCacheBlockCount = 32;
+
+				//------------------------------------------------------------------------------
+				struct SharedBlockPool
+				{
+				public:
+					moodycamel::ConcurrentQueue<void *>	freeBlocks[kBlockSizeClassCount];
+					std::atomic_int						pooledCount[kBlockSizeClassCount];
+
+				public:
+					SharedBlockPool()
+					{
+						for (int i = 0; i < kBlockSizeClassCount; ++i)
+						{
+							pooledCount[i].store(0);
+						}
+					}
+				};
+
+				//------------------------------------------------------------------------------
+				// Intentionally not destroyed, for blocks freed during static destruction
+				SharedBlockPool &GetSharedBlockPool()
+				{
+					static SharedBlockPool *s_sharedPool = new SharedBlockPool();
+					return *s_sharedPool;
+				}
+
+				//------------------------------------------------------------------------------
+				void ReturnToSharedPool(int sizeClassIndex, void *block)
+				{
+					SharedBlockPool &sharedPool = GetSharedBlockPool();
+					if (sharedPool.pooledCount[sizeClassIndex].fetch_add(1, std::memory_order_relaxed) < kMaxSharedPooledBlockCount)
+					{
+						if (sharedPool.freeBlocks[sizeClassIndex].enqueue(block))
+						{
+							return;
+						}
+					}
+					sharedPool.pooledCount[sizeClassIndex].fetch_sub(1, std::memory_order_relaxed);
+
+					::operator delete(block);
+				}
+
+				// Blocks can be freed by other thread-local destructors after the cache is gone
+				thread_local bool t_isBlockCacheDestroyed = false;
+
+				//------------------------------------------------------------------------------
+				struct ThreadBlockCache
+				{
+				public:
+					void	*blocks[kBlockSizeClassCount][kThreadCacheBlockCount];
+					int		count[kBlockSizeClassCount];
+
+				public:
+					ThreadBlockCache()
+					{
+						for (int i = 0; i < kBlockSizeClassCount; ++i)
+						{
+							count[i] = 0;
+						}
+					}
+
+					~ThreadBlockCache()
+					{
+						t_isBlockCacheDestroyed = true;
+
+						// Give cached blocks back on thread exit
+						for (int i = 0; i < kBlockSizeClassCount; ++i)
+						{
+							while (count[i] > 0)
+							{
+								--count[i];
+								ReturnToSharedPool(i, blocks[i][count[i]]);
+							}
+						}
+					}
+				};
+
+				thread_local ThreadBlockCache t_blockCache;
+
+				//------------------------------------------------------------------------------
+				ThreadBlockCache *GetThreadBlockCache()
+				{
+					if (t_isBlockCacheDestroyed)
+					{
+						return nullptr;
+					}
+					return &t_blockCache;
+				}
+
+				//------------------------------------------------------------------------------
+				int GetSizeClassIndex(std::size_t blockSize)
+				{
+					for (int i = 0; i < kBlockSizeClassCount; ++i)
+					{
+						if (blockSize <= kBlockSizeClasses[i])
+						{
+							return i;
+						}
+					}
+					return -1;
+				}
+			}
+
+
+			//////////////////////////////////////////////////////////////////////////////// Task Memory Pool
+
+			//------------------------------------------------------------------------------
+			// Get a block of at least the size, aligned for any fundamental type
+			void *AllocateTaskMemoryBlock(std::size_t blockSize)
+			{
+				int sizeClassIndex = GetSizeClassIndex(blockSize);
+				if (sizeClassIndex < 0)
+				{
+					// Too big block
+					return ::operator new(blockSize);
+				}
+
+				ThreadBlockCache *threadCache = GetThreadBlockCache();
+				if (threadCache != nullptr && threadCache->count[sizeClassIndex] > 0)
+				{
+					--threadCache->count[sizeClassIndex];
+					return threadCache->blocks[sizeClassIndex][threadCache->count[sizeClassIndex]];
+				}
+
+				SharedBlockPool &sharedPool = GetSharedBlockPool();
+				void *pooledBlock = nullptr;
+				if (sharedPool.freeBlocks[sizeClassIndex].try_dequeue(pooledBlock))
+				{
+					sharedPool.pooledCount[sizeClassIndex].fetch_sub(1, std::memory_order_relaxed);
+					return pooledBlock;
+				}
+
+				return ::operator new(kBlockSizeClasses[sizeClassIndex]);
+			}
+
+			//------------------------------------------------------------------------------
+			// Return a block; the size should be the same one given at the allocation
+			void FreeTaskMemoryBlock(void *block, std::size_t blockSize)
+			{
+				if (block == nullptr)
+				{
+					return;
+				}
+
+				int sizeClassIndex = GetSizeClassIndex(blockSize);
+				if (sizeClassIndex < 0)
+				{
+					::operator delete(block);
+					return;
+				}
+
+				ThreadBlockCache *threadCache = GetThreadBlockCache();
+				if (threadCache != nullptr && threadCache->count[sizeClassIndex] < kThreadCacheBlockCount)
+				{
+					threadCache->blocks[sizeClassIndex][threadCache->count[sizeClassIndex]] = block;
+					++threadCache->count[sizeClassIndex];
+					return;
+				}
+
+				ReturnToSharedPool(sizeClassIndex, block);
+			}
+		}
+	}
+}
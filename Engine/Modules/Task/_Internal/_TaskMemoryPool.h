@@ -0,0 +1,71 @@
+﻿////////////////////////////////////////////////////////////////////////////////
+// _Internal/_TaskMemoryPool.h (Leggiero/Modules - Task)
+//
+// Pooled memory blocks for task objects and coroutine frames
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LM_TASK___INTERNAL___TASK_MEMORY_POOL_H
+#define __LM_TASK___INTERNAL___TASK_MEMORY_POOL_H
+
+
+// Leggiero.Basic
+#include <Basic/LeggieroBasic.h>
+
+// Standard Library
+#include <cstddef>
+#include <new>
+
+
+namespace Leggiero
+{
+	namespace Task
+	{
+		namespace _Internal
+		{
+			// Blocks are recycled by size classes up to this size; bigger ones go to the heap directly
+			constexpr std::size_t kMaxPooledTaskMemoryBlockSize = 4096;
+
+			// Get a block of at least the size, aligned for any fundamental type
+			void *AllocateTaskMemoryBlock(std::size_t blockSize);
+
+			// Return a block; the size should be the same one given at the allocation
+			void FreeTaskMemoryBlock(void *block, std::size_t blockSize);
+
+
+			// Standard allocator over the task memory pool, for std::allocate_shared
+			template <typename T>
+			class TaskMemoryPoolAllocator
+			{
+			public:
+				using value_type = T;
+
+			public:
+				TaskMemoryPoolAllocator() noexcept { }
+
+				template <typename OtherT>
+				TaskMemoryPoolAllocator(const TaskMemoryPoolAllocator<OtherT> &/*other*/) noexcept { }
+
+			public:
+				T *allocate(std::size_t count)
+				{
+					static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned type cannot be pooled");
+					return static_cast<T *>(AllocateTaskMemoryBlock(sizeof(T) * count));
+				}
+
+				void deallocate(T *pointer, std::size_t count) noexcept
+				{
+					FreeTaskMemoryBlock(pointer, sizeof(T) * count);
+				}
+
+			public:
+				template <typename OtherT>
+				bool operator==(const TaskMemoryPoolAllocator<OtherT> &/*other*/) const noexcept { return true; }
+
+				template <typename OtherT>
+				bool operator!=(const TaskMemoryPoolAllocator<OtherT> &/*other*/) const noexcept { return false; }
+			};
+		}
+	}
+}
+
+#endif
@@ -7,6 +7,9 @@
 // My Header
 #include "AndroidPlatformApplication.h"
 
+// Leggiero.Utility
+#include <Utility/Sugar/Finally.h>
+
 // Leggiero.Platform.Android
 #include "AndroidPlatform/AndroidJNISupport.h"
 